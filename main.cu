@@ -28,30 +28,33 @@ void runPagerankBatch(const G& xo, int repeat, int steps, int batch) {
   vector<T> *init = nullptr;
   random_device dev;
   default_random_engine rnd(dev());
+  PagerankOptions<T> oa(repeat, Li);
+  oa.asynchronous = true;
+
+  printf("Performing operation `selfLoop()` ...\n");
+  auto x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); });
+  printf("Performing operation `transposeWithDegreeOmp()` ...\n");
+  DiGraph<int> xt; transposeWithDegreeOmp(xt, x);
+  printf("Performing operation `vertices()` ...\n");
+  auto ksOld = vertices(x);
+  printf("Performing operation `pagerankDataOmp()` ...\n");
+  auto Dx = pagerankDataOmp(x, xt);
 
   for (int i=0; i<steps; i++) {
-    printf("Performing operation `selfLoop()` ...\n");
-    auto x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); });
-    printf("Performing operation `transposeWithDegree()` ...\n");
-    auto xt = transposeWithDegree(x);
-    printf("Performing operation `vertices()` ...\n");
-    auto ksOld = vertices(x);
     // pagerankNvgraph(x, xt, init, {repeat});
     printf("Performing operation `pagerankMonolithicCuda()` ...\n");
     auto a0 = pagerankMonolithicCuda(x, xt, init, {repeat});
     auto r0 = a0.ranks;
 
     // Add random edges for this batch.
-    printf("Performing operation `copy()` ...\n");
-    auto yo = copy(xo);
-    printf("Performing operation `addRandomEdge()` ...\n");
-    for (int i=0; i<batch; i++)
-      addRandomEdge(yo, rnd, span);
-    yo.correct();
-    printf("Performing operation `selfLoop()` ...\n");
-    auto y  = selfLoop(yo, [&](int u) { return isDeadEnd(yo, u); });
-    printf("Performing operation `transposeWithDegree()` ...\n");
-    auto yt = transposeWithDegree(y);
+    printf("Performing operation `randomBatch()` ...\n");
+    auto ins = randomBatch(rnd, span, batch);
+    // Update graph in place, and undo after insertions (no copy is made).
+    printf("Performing operation `updateBatchOmp()` ...\n");
+    auto bu = undoBatch(x, {}, ins);
+    auto cv = updateBatchOmp(x, xt, {}, ins);
+    const auto& y  = x;
+    const auto& yt = xt;
     printf("Performing operation `vertices()` ...\n");
     auto ks = vertices(y);
     vector<T> s0(y.span());
@@ -63,14 +66,10 @@ void runPagerankBatch(const G& xo, int repeat, int steps, int batch) {
     printf("Performing operation `adjustRanks()` ...\n");
     adjustRanks(s0, r0, ksOld, ks, 0.0f, float(X)/(Y+1), 1.0f/(Y+1));
 
-    // Find Pagerank data.
-    printf("Performing operation `components()` ...\n");
-    auto cs  = components(y, yt);
-    printf("Performing operation `blockgraph()` ...\n");
-    auto b   = blockgraph(y, cs);
-    printf("Performing operation `transpose()` ...\n");
-    auto bt  = transpose(b);
-    PagerankData<G> D {move(b), move(bt), move(cs)};
+    // Find Pagerank data (update from original graph).
+    printf("Performing operation `pagerankDataOmp()` ...\n");
+    auto D = pagerankDataOmp(Dx, y, yt, decltype(ins)(), ins);
+    D.changedVertices = cv;
 
     // Find nvGraph-based pagerank.
     auto b0 = pagerankNvgraph(y, yt, init, {repeat});
@@ -110,6 +109,20 @@ void runPagerankBatch(const G& xo, int repeat, int steps, int batch) {
     // auto j2 = pagerankMonolithicOmpDynamic(x, xt, y, yt, &s0, {repeat, Li, 1, true}, &D);
     // printRow(y, b0, j2, "I:pagerankMonolithicOmpSplit (dynamic)");
 
+    // Find OpenMP-based Monolithic pagerank (dynamic frontier).
+    auto n2 = pagerankMonolithicOmpDynamicFrontier(x, xt, y, yt, &s0, {repeat, Li}, &D);
+    printRow(y, b0, n2, "I:pagerankMonolithicOmpFrontier (dynamic)");
+
+    // Find OpenMP-based Monolithic pagerank (fused, asynchronous).
+    auto p2 = pagerankMonolithicOmpFused(y, yt, init, {repeat, Li}, &D);
+    printRow(y, b0, p2, "I:pagerankMonolithicOmpFused (static)");
+    auto q2 = pagerankMonolithicOmpFused(y, yt, init, oa, &D);
+    printRow(y, b0, q2, "I:pagerankMonolithicOmpAsync (static)");
+    auto r2 = pagerankMonolithicOmpFused(y, yt, &s0, oa, &D);
+    printRow(y, b0, r2, "I:pagerankMonolithicOmpAsync (incremental)");
+    auto s2 = pagerankMonolithicOmpDynamicFused(x, xt, y, yt, &s0, oa, &D);
+    printRow(y, b0, s2, "I:pagerankMonolithicOmpAsync (dynamic)");
+
     // Find CUDA-based Monolithic pagerank.
     // auto b3 = pagerankMonolithicCuda(y, yt, init, {repeat, Li, MIN_COMPUTE_CUDA}, &D);
     // printRow(y, b0, b3, "I:pagerankMonolithicCuda (static)");
@@ -157,14 +170,10 @@ void runPagerankBatch(const G& xo, int repeat, int steps, int batch) {
     printf("Performing operation `adjustRanks()` ...\n");
     adjustRanks(r1, s1, ks, ksOld, 0.0f, float(Y)/(X+1), 1.0f/(X+1));
 
-    // Find Pagerank data.
-    printf("Performing operation `components()` ...\n");
-    auto ds = components(x, xt);
-    printf("Performing operation `blockgraph()` ...\n");
-    auto c  = blockgraph(x, ds);
-    printf("Performing operation `transpose()` ...\n");
-    auto ct = transpose(c);
-    PagerankData<G> E {move(c), move(ct), move(ds)};
+    // Undo insertions, and find Pagerank data (of original graph).
+    printf("Performing operation `updateBatchOmp()` ...\n");
+    auto E = Dx;
+    E.changedVertices = updateBatchOmp(x, xt, bu);
 
     // Find nvGraph-based pagerank.
     auto e0 = pagerankNvgraph(x, xt, init, {repeat, Li});
@@ -204,6 +213,20 @@ void runPagerankBatch(const G& xo, int repeat, int steps, int batch) {
     // auto m2 = pagerankMonolithicOmpDynamic(y, yt, x, xt, &r1, {repeat, Li, 1, true}, &E);
     // printRow(y, e0, m2, "D:pagerankMonolithicOmpSplit (dynamic)");
 
+    // Find OpenMP-based Monolithic pagerank (dynamic frontier).
+    auto o2 = pagerankMonolithicOmpDynamicFrontier(y, yt, x, xt, &r1, {repeat, Li}, &E);
+    printRow(y, e0, o2, "D:pagerankMonolithicOmpFrontier (dynamic)");
+
+    // Find OpenMP-based Monolithic pagerank (fused, asynchronous).
+    auto t2 = pagerankMonolithicOmpFused(x, xt, init, {repeat, Li}, &E);
+    printRow(y, e0, t2, "D:pagerankMonolithicOmpFused (static)");
+    auto u2 = pagerankMonolithicOmpFused(x, xt, init, oa, &E);
+    printRow(y, e0, u2, "D:pagerankMonolithicOmpAsync (static)");
+    auto v2 = pagerankMonolithicOmpFused(x, xt, &r1, oa, &E);
+    printRow(y, e0, v2, "D:pagerankMonolithicOmpAsync (incremental)");
+    auto w2 = pagerankMonolithicOmpDynamicFused(y, yt, x, xt, &r1, oa, &E);
+    printRow(y, e0, w2, "D:pagerankMonolithicOmpAsync (dynamic)");
+
     // Find CUDA-based Monolithic pagerank.
     // auto e3 = pagerankMonolithicCuda(x, xt, init, {repeat, Li, MIN_COMPUTE_CUDA}, &E);
     // printRow(y, e0, e3, "D:pagerankMonolithicCuda (static)");
@@ -260,9 +283,11 @@ void runPagerank(const G& x, int repeat) {
 int main(int argc, char **argv) {
   char *file = argv[1];
   int repeat = argc>2? stoi(argv[2]) : 5;
+  char *cache = argc>3? argv[3] : nullptr;  // binary CSR cache (optional)
+  setScheduleOmp();  // vertex/edge loops: OMP_SCHEDULE, or dynamic
   printf("Loading graph %s ...\n", file);
   auto fs = [&](float p) { printf("Reading edges [%04.1f]%% ...\n", 100*p); };
-  auto x  = readMtx(file, fs); println(x);
+  auto x  = readMtxOmp(file, cache, fs); println(x);
   runPagerank(x, repeat);
   printf("\n");
   return 0;
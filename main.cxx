@@ -0,0 +1,554 @@
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <tuple>
+#include <random>
+#include <algorithm>
+#include "src/main.hxx"
+
+using namespace std;
+
+
+
+
+// OPTIONS
+// -------
+// CPU-only benchmark: no CUDA, no nvGraph (reference is a tight OpenMP run).
+
+#define ENGINES "MonolithicSeq,MonolithicOmp,MonolithicOmpFused,MonolithicOmpAsync,MonolithicOmpFrontier,LevelwiseSeq,LevelwiseOmp,ComponentwiseSeq,ComponentwiseOmp"
+#define MODES   "static,incremental,dynamic"
+
+struct Options {
+  const char *file   = nullptr;
+  const char *cache  = nullptr;  // binary CSR cache
+  const char *output = nullptr;  // records file (stdout if none)
+  const char *ranks  = nullptr;  // ranks file, per batch (stream)
+  FILE       *out    = stdout;
+  vector<string> engines;
+  vector<string> modes;
+  vector<int> batches;
+  vector<int> threads;
+  int  repeat = 5;
+  int  steps  = 1;
+  int  norm   = 3;
+  int  top    = 10;     // ranks written per batch, 0 => all (stream)
+  int  schedule = 0;    // OpenMP schedule of runtime loops, omp_sched_t (0 => OMP_SCHEDULE, or dynamic)
+  int  chunk  = 0;      // chunk size of runtime loops (0 => CHUNK_SIZE)
+  bool json   = false;
+  bool perf   = false;
+  bool reduce = false;  // also solve on reduced graph
+  bool check  = false;  // check updated components against full recompute
+  bool temporal = false;  // stream temporal edges, updating ranks
+  bool help   = false;
+  string error;
+};
+
+
+vector<string> splitList(const char *x) {
+  vector<string> a; string s;
+  for (; *x; x++) {
+    if (*x != ',') { s += *x; continue; }
+    if (!s.empty()) a.push_back(s);
+    s.clear();
+  }
+  if (!s.empty()) a.push_back(s);
+  return a;
+}
+
+// Read OpenMP schedule as kind[,chunk], kind 0 if unknown.
+void readSchedule(int& k, int& c, const char *x) {
+  auto s = splitList(x);
+  string n = s.empty()? "" : s[0];
+  k = n=="static"? omp_sched_static : n=="dynamic"? omp_sched_dynamic : n=="guided"? omp_sched_guided : n=="auto"? omp_sched_auto : 0;
+  c = s.size()>1? stoi(s[1]) : 0;
+}
+
+vector<int> splitIntegers(const char *x) {
+  vector<int> a;
+  for (const auto& s : splitList(x))
+    a.push_back(int(stod(s)));  // allows 1e3
+  return a;
+}
+
+
+Options readOptions(int argc, char **argv) {
+  Options o;
+  for (int i=1; i<argc; i++) {
+    string k = argv[i];
+    bool   v = i+1<argc;
+    if (k=="-h" || k=="--help") o.help = true;
+    else if (k=="--json") o.json = true;
+    else if (k=="--perf") o.perf = true;
+    else if (k=="--reduce") o.reduce = true;
+    else if (k=="--check")  o.check  = true;
+    else if (k=="--temporal") o.temporal = true;
+    else if (v && (k=="-e" || k=="--engines"))  o.engines = splitList(argv[++i]);
+    else if (v && (k=="-m" || k=="--modes"))    o.modes   = splitList(argv[++i]);
+    else if (v && (k=="-b" || k=="--batches"))  o.batches = splitIntegers(argv[++i]);
+    else if (v && (k=="-t" || k=="--threads"))  o.threads = splitIntegers(argv[++i]);
+    else if (v && (k=="-r" || k=="--repeat"))   o.repeat  = stoi(argv[++i]);
+    else if (v && (k=="-s" || k=="--steps"))    o.steps   = stoi(argv[++i]);
+    else if (v && (k=="-n" || k=="--norm"))     o.norm    = stoi(argv[++i]);
+    else if (v && (k=="-c" || k=="--cache"))    o.cache   = argv[++i];
+    else if (v && (k=="-o" || k=="--output"))   o.output  = argv[++i];
+    else if (v && (k=="-k" || k=="--top"))      o.top     = stoi(argv[++i]);
+    else if (v && k=="--ranks") o.ranks = argv[++i];
+    else if (v && k=="--schedule") {
+      readSchedule(o.schedule, o.chunk, argv[++i]);
+      if (!o.schedule) { o.error = "Unknown schedule: " + string(argv[i]); break; }
+    }
+    else if ((k[0]!='-' || k=="-") && !o.file) o.file = argv[i];
+    else { o.error = "Unknown option: " + k; break; }
+  }
+  if (o.engines.empty()) o.engines = splitList(o.temporal? "MonolithicOmpFrontier" : ENGINES);
+  if (o.modes.empty())   o.modes   = splitList(o.temporal? "dynamic" : MODES);
+  if (o.batches.empty()) o.batches = {1000};
+  if (o.threads.empty()) o.threads = {0};
+  if (!o.file && !o.help && o.error.empty()) o.error = "No graph file given";
+  return o;
+}
+
+
+void printHelp(const char *name) {
+  fprintf(stderr,
+    "usage: %s [options] <graph.mtx>\n"
+    "       %s [options] --temporal <edges.txt | ->\n"
+    "  -e, --engines <list>  engines to run [" ENGINES "]\n"
+    "  -m, --modes <list>    modes to run [" MODES "]\n"
+    "  -b, --batches <list>  batch sizes, random edges [1000]\n"
+    "  -t, --threads <list>  OpenMP thread counts, 0 => default [0]\n"
+    "  -r, --repeat <n>      repeats of each solve [5]\n"
+    "  -s, --steps <n>       batches of each size [1]\n"
+    "  -n, --norm <n>        tolerance norm, 1/2/3 => L1/L2/Li [3]\n"
+    "      --schedule <s>    OpenMP schedule of vertex/edge loops, kind[,chunk]\n"
+    "                        (static/dynamic/guided/auto) [OMP_SCHEDULE, or dynamic,2048]\n"
+    "  -c, --cache <file>    binary CSR cache of graph\n"
+    "  -o, --output <file>   write records to file (engines may log to stdout)\n"
+    "      --json            write JSON (default CSV)\n"
+    "      --perf            count instructions, cycles, cache references/misses\n"
+    "                        (bandwidth is estimated from last-level cache misses)\n"
+    "      --reduce          also solve on graph reduced by identicals and chains\n"
+    "                        (ranks are expanded, speedup is over full graph)\n"
+    "      --check           check updated components and blockgraph against\n"
+    "                        a full recompute, after each update (slow)\n"
+    "      --temporal        stream SNAP temporal edges (file, or - for stdin),\n"
+    "                        parsing next batch while ranks of this one are\n"
+    "                        updated; uses first engine, mode, batch, threads\n"
+    "                        [MonolithicOmpFrontier, dynamic]\n"
+    "      --ranks <file>    write top ranks of each batch (stream)\n"
+    "  -k, --top <k>         ranks written per batch, 0 => all [10]\n", name, name);
+}
+
+
+
+
+// RECORD
+// ------
+// One row per measured phase, and per solve (with engine, mode, threads).
+
+struct Record {
+  string graph;
+  int    order = 0, size = 0;
+  int    batch = 0, step = 0;
+  char   update = '-';  // I: insertions, D: deletions, M: mixed
+  string phase, engine, mode;
+  int    threads = 0;
+  float  time = 0;
+  int    iterations = 0;
+  double error = 0;
+  PerfCounts perf;
+  double bandwidth = -1;  // GB/s
+  double vertexReduction = 0, edgeReduction = 0;  // fraction removed
+  double speedup = -1;    // of reduced solve
+  double throughput = -1; // edges/s (stream)
+};
+
+
+void writeRecord(FILE *f, const Record& r, bool json, bool first) {
+  const auto& p = r.perf;
+  if (json) {
+    fprintf(f, "%s\n  {\"graph\": \"%s\", \"order\": %d, \"size\": %d, \"batch\": %d, \"step\": %d, \"update\": \"%c\", ", first? "[" : ",", r.graph.c_str(), r.order, r.size, r.batch, r.step, r.update);
+    fprintf(f, "\"phase\": \"%s\", \"engine\": \"%s\", \"mode\": \"%s\", \"threads\": %d, ", r.phase.c_str(), r.engine.c_str(), r.mode.c_str(), r.threads);
+    fprintf(f, "\"time\": %.3f, \"iterations\": %d, ", r.time, r.iterations);
+    if (isfinite(r.error)) fprintf(f, "\"error\": %.4e, ", r.error);
+    else fprintf(f, "\"error\": null, ");  // inf/nan are not JSON
+    fprintf(f, "\"instructions\": %lld, \"cycles\": %lld, \"cacheReferences\": %lld, \"cacheMisses\": %lld, \"bandwidth\": %.3f, ", (long long) p.instructions, (long long) p.cycles, (long long) p.cacheReferences, (long long) p.cacheMisses, r.bandwidth);
+    fprintf(f, "\"vertexReduction\": %.4f, \"edgeReduction\": %.4f, \"speedup\": %.3f, \"throughput\": %.1f}", r.vertexReduction, r.edgeReduction, r.speedup, r.throughput);
+  }
+  else {
+    if (first) fprintf(f, "graph,order,size,batch,step,update,phase,engine,mode,threads,time,iterations,error,instructions,cycles,cacheReferences,cacheMisses,bandwidth,vertexReduction,edgeReduction,speedup,throughput\n");
+    fprintf(f, "%s,%d,%d,%d,%d,%c,%s,%s,%s,%d,", r.graph.c_str(), r.order, r.size, r.batch, r.step, r.update, r.phase.c_str(), r.engine.c_str(), r.mode.c_str(), r.threads);
+    fprintf(f, "%.3f,%d,%.4e,%lld,%lld,%lld,%lld,%.3f,", r.time, r.iterations, r.error, (long long) p.instructions, (long long) p.cycles, (long long) p.cacheReferences, (long long) p.cacheMisses, r.bandwidth);
+    fprintf(f, "%.4f,%.4f,%.3f,%.1f\n", r.vertexReduction, r.edgeReduction, r.speedup, r.throughput);
+  }
+  fflush(f);
+}
+
+
+
+
+// RUN-ENGINE
+// ----------
+// Solve on graph (y), with ranks of graph (x) as initial ranks (q) when
+// incremental/dynamic. Returns false if the engine lacks the mode.
+
+template <class G, class H, class T>
+bool runEngine(PagerankResult<T>& a, const string& e, const string& m, const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q, const PagerankOptions<T>& o, const PagerankData<G>& D) {
+  bool s = m=="static", i = m=="incremental", d = m=="dynamic";
+  if (!s && !i && !d) return false;
+  const vector<T> *qi = s? nullptr : q;
+  auto oa = o; oa.asynchronous = true;
+  if (e=="MonolithicSeq")      a = d? pagerankMonolithicSeqDynamic(x, xt, y, yt, q, o, &D) : pagerankMonolithicSeq(y, yt, qi, o, &D);
+  else if (e=="MonolithicOmp") a = d? pagerankMonolithicOmpDynamic(x, xt, y, yt, q, o, &D) : pagerankMonolithicOmp(y, yt, qi, o, &D);
+  else if (e=="MonolithicOmpFused")  a = d? pagerankMonolithicOmpDynamicFused(x, xt, y, yt, q, o, &D)  : pagerankMonolithicOmpFused(y, yt, qi, o, &D);
+  else if (e=="MonolithicOmpAsync")  a = d? pagerankMonolithicOmpDynamicFused(x, xt, y, yt, q, oa, &D) : pagerankMonolithicOmpFused(y, yt, qi, oa, &D);
+  else if (e=="MonolithicOmpFrontier") { if (!d) return false; a = pagerankMonolithicOmpDynamicFrontier(x, xt, y, yt, q, o, &D); }
+  else if (e=="LevelwiseSeq")     a = d? pagerankLevelwiseSeqDynamic(x, xt, y, yt, q, o, &D) : pagerankLevelwiseSeq(y, yt, qi, o, &D);
+  else if (e=="LevelwiseOmp")     a = d? pagerankLevelwiseOmpDynamic(x, xt, y, yt, q, o, &D) : pagerankLevelwiseOmp(y, yt, qi, o, &D);
+  else if (e=="ComponentwiseSeq") a = d? pagerankComponentwiseSeqDynamic(x, xt, y, yt, q, o, D) : pagerankComponentwiseSeq(y, yt, qi, o, D);
+  else if (e=="ComponentwiseOmp") a = d? pagerankComponentwiseOmpDynamic(x, xt, y, yt, q, o, D) : pagerankComponentwiseOmp(y, yt, qi, o, D);
+  else return false;
+  return true;
+}
+
+
+// Reduced graphs of an update (x -> y), with a reduction valid for both.
+template <class G, class H>
+struct ReducedUpdate {
+  const PagerankReduction *R = nullptr;  // none => no reduced solves
+  const G *x = nullptr, *y = nullptr;
+  const H *xt = nullptr, *yt = nullptr;
+  const PagerankData<G> *D = nullptr;
+};
+
+
+// Run selected engines, modes, and thread counts on one update (x -> y).
+// With a reduction, each solve is followed by one on the reduced graph.
+template <class G, class H, class HR, class T>
+void runEngines(Record r, const Options& p, const PerfEvents& pe, const G& x, const H& xt, const G& y, const H& yt, const vector<T>& q, const vector<T>& ref, const PagerankData<G>& D, const ReducedUpdate<G, HR>& u, bool& first) {
+  auto fw = [&](const char *phase, const PagerankResult<T>& a, const PerfCounts& c, float tw) {
+    r.phase = phase;
+    r.time  = a.time;
+    r.iterations = a.iterations;
+    r.error = l1Norm(ref, a.ranks);
+    r.perf  = c;
+    r.bandwidth = c.cacheMisses<0 || tw<=0? -1 : c.cacheMisses * 64.0 / (tw * 1e6);
+    writeRecord(p.out, r, p.json, first); first = false;
+  };
+  for (const auto& e : p.engines) {
+    bool seq = e.find("Seq") != string::npos;
+    for (const auto& m : p.modes) {
+      for (int t : p.threads) {
+        PagerankOptions<T> o(p.repeat, p.norm);
+        o.numThreads = seq? 1 : t;
+        o.schedule   = p.schedule; o.chunkSize = p.chunk;
+        PagerankResult<T> a; bool ok = false; PerfCounts c;
+        fprintf(stderr, "Running %s (%s) on %d threads ...\n", e.c_str(), m.c_str(), t);
+        float tw = measureDuration([&] { c = measurePerf(pe, [&] { ok = runEngine(a, e, m, x, xt, y, yt, &q, o, D); }); });
+        if (!ok) { fprintf(stderr, "Skipping %s (%s): not supported\n", e.c_str(), m.c_str()); break; }
+        r.engine  = e; r.mode = m;
+        r.threads = seq? 1 : t>0? t : omp_get_max_threads();
+        r.vertexReduction = 0; r.edgeReduction = 0; r.speedup = -1;
+        fw("solve", a, c, tw);
+        if (u.R) {
+          auto fe = [&](const vector<T> *qr, const PagerankOptions<T>& oq) {
+            PagerankResult<T> b;
+            runEngine(b, e, m, *u.x, *u.xt, *u.y, *u.yt, qr, oq, *u.D);
+            return b;
+          };
+          PagerankResult<T> b;
+          fprintf(stderr, "Running %s (%s) on %d threads, reduced ...\n", e.c_str(), m.c_str(), t);
+          tw = measureDuration([&] { c = measurePerf(pe, [&] { b = pagerankReduced(yt, *u.R, *u.yt, fe, &q, o); }); });
+          r.vertexReduction = 1 - double(u.yt->order()) / max(yt.order(), 1);
+          r.edgeReduction   = 1 - double(u.yt->size())  / max(yt.size(),  1);
+          r.speedup = b.time>0? a.time / b.time : -1;
+          fw("solveReduced", b, c, tw);
+        }
+        if (seq) break;
+      }
+    }
+  }
+}
+
+
+
+
+// RUN-BENCHMARK
+// -------------
+
+float writePhase(Record r, const char *phase, float time, const Options& p, bool& first) {
+  r.phase = phase;
+  r.time  = time;
+  writeRecord(p.out, r, p.json, first); first = false;
+  return r.time;
+}
+
+template <class F>
+float measurePhase(Record r, const char *phase, const Options& p, bool& first, F fn) {
+  fprintf(stderr, "Performing phase `%s` ...\n", phase);
+  return writePhase(r, phase, measureDuration(fn), p, first);
+}
+
+
+// Do components and blockgraph of an update match a full recompute?
+// Components are named by their smallest vertex, as order may differ.
+template <class G, class H>
+bool checkComponents(const PagerankData<G>& D, const G& y, const H& yt) {
+  auto fc = [](const PagerankData<G>& D) {
+    auto cs = D.components;
+    vector<int> ks;
+    vector<pair<int, int>> es;
+    for (auto& c : cs) {
+      sort(c.begin(), c.end());
+      ks.push_back(c[0]);
+    }
+    for (int i : D.blockgraph.vertices())
+      for (int j : D.blockgraph.edges(i))
+        es.push_back({ks[i], ks[j]});
+    sort(cs.begin(), cs.end());
+    sort(es.begin(), es.end());
+    return make_pair(cs, es);
+  };
+  return fc(D) == fc(pagerankDataOmp(y, yt));
+}
+
+template <class G, class H>
+bool checkComponents(const PagerankData<G>& D, const G& y, const H& yt, char update) {
+  if (checkComponents(D, y, yt)) return true;
+  fprintf(stderr, "Components of update %c differ from full recompute\n", update);
+  return false;
+}
+
+
+template <class G>
+bool runBenchmark(const G& xo, Record r, const Options& p, const PerfEvents& pe, bool& first) {
+  using T = float;
+  int span = int(1.1 * xo.span());
+  random_device dev;
+  default_random_engine rnd(dev());
+  PagerankOptions<T> oref(1, 1, 1, false, 0.85f, 1e-10f);
+  bool ok = true;
+  // Prepare original graph, once.
+  G x; DiGraph<int> xt; PagerankData<G> Dx; PagerankResult<T> a0;
+  measurePhase(r, "selfLoop",   p, first, [&] { x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); }); });
+  measurePhase(r, "transpose",  p, first, [&] { transposeWithDegreeOmp(xt, x); });
+  measurePhase(r, "components", p, first, [&] { Dx = pagerankDataOmp(x, xt); });
+  measurePhase(r, "reference",  p, first, [&] { a0 = pagerankMonolithicOmp(x, xt, (vector<T>*) nullptr, oref); });
+  // Reduce original graph, and reuse it for batches that leave it valid.
+  PagerankReduction R; G xr; DiGraphCsr<int> xrt; PagerankData<G> Dxr; bool rx = false;
+  if (p.reduce) measurePhase(r, "reduce", p, first, [&] { R = pagerankReduction(x, xt); });
+  auto ksOld = vertices(x);
+  int  X = ksOld.size();
+  // Each batch updates the graph (and its transpose) in place, and is undone
+  // after, so no graph is copied or transposed again. Engines get the graph
+  // as both old and new, and find affected vertices from changed vertices.
+  for (int batch : p.batches) {
+    for (int step=0; step<p.steps; step++) {
+      r.batch = batch; r.step = step;
+      // Apply random insertions (x -> y).
+      auto ins = randomBatch(rnd, span, batch);
+      auto bu  = undoBatch(x, {}, ins);
+      vector<int> cv; PagerankData<G> D; PagerankResult<T> b0;
+      r.update = 'I';
+      measurePhase(r, "update",     p, first, [&] { cv = updateBatchOmp(x, xt, {}, ins); });
+      measurePhase(r, "components", p, first, [&] { D  = pagerankDataOmp(Dx, x, xt, decltype(ins)(), ins); });
+      measurePhase(r, "reference",  p, first, [&] { b0 = pagerankMonolithicOmp(x, xt, (vector<T>*) nullptr, oref); });
+      D.changedVertices = cv;
+      if (p.check) ok &= checkComponents(D, x, xt, r.update);
+      // Reduction excluding changed vertices is valid for both x and y.
+      G yr; DiGraphCsr<int> yrt; PagerankData<G> Dyr;
+      ReducedUpdate<G, DiGraphCsr<int>> ui, ud;
+      if (p.reduce) {
+        if (pagerankReductionAffected(R, cv)) {
+          measurePhase(r, "reduce", p, first, [&] { R = pagerankReduction(x, xt, cv); });
+          rx = false;
+        }
+        measurePhase(r, "reduceGraph", p, first, [&] { tie(yr, yrt) = pagerankReduceGraph(R, x, xt); });
+        measurePhase(r, "components",  p, first, [&] { Dyr = pagerankDataOmp(yr, yrt); });
+        Dyr.changedVertices = cv;
+        ui = {&R, &yr, &yr, &yrt, &yrt, &Dyr};
+      }
+      auto ks = vertices(x);
+      int  Y  = ks.size();
+      vector<T> s0(x.span());
+      adjustRanks(s0, a0.ranks, ksOld, ks, 0.0f, float(X)/(Y+1), 1.0f/(Y+1));
+      runEngines(r, p, pe, x, xt, x, xt, s0, b0.ranks, D, ui, first);
+      // Undo them, as deletions (y -> x).
+      vector<T> r1(x.span());
+      adjustRanks(r1, b0.ranks, ks, ksOld, 0.0f, float(Y)/(X+1), 1.0f/(X+1));
+      auto E = Dx;
+      r.update = 'D';
+      measurePhase(r, "update", p, first, [&] { E.changedVertices = updateBatchOmp(x, xt, bu); });
+      auto Er = Dxr;
+      if (p.reduce) {
+        if (!rx) {
+          measurePhase(r, "reduceGraph", p, first, [&] { tie(xr, xrt) = pagerankReduceGraph(R, x, xt); });
+          measurePhase(r, "components",  p, first, [&] { Dxr = pagerankDataOmp(xr, xrt); });
+          rx = true;
+          Er = Dxr;
+        }
+        Er.changedVertices = E.changedVertices;
+        ud = {&R, &xr, &xr, &xrt, &xrt, &Er};
+      }
+      runEngines(r, p, pe, x, xt, x, xt, r1, a0.ranks, E, ud, first);
+      // Delete existing edges, and insert random ones (x -> z). This may split
+      // components, and add new vertices, in one batch.
+      auto del = randomDeleteBatch(rnd, x, batch/2);
+      auto inz = randomBatch(rnd, span, batch - batch/2);
+      auto bz  = undoBatch(x, del, inz);
+      vector<int> cz; PagerankData<G> Dz; PagerankResult<T> c0;
+      r.update = 'M';
+      measurePhase(r, "update",     p, first, [&] { cz = updateBatchOmp(x, xt, del, inz); });
+      measurePhase(r, "components", p, first, [&] { Dz = pagerankDataOmp(Dx, x, xt, del, inz); });
+      measurePhase(r, "reference",  p, first, [&] { c0 = pagerankMonolithicOmp(x, xt, (vector<T>*) nullptr, oref); });
+      Dz.changedVertices = cz;
+      if (p.check) ok &= checkComponents(Dz, x, xt, r.update);
+      auto kz = vertices(x);
+      int  Z  = kz.size();
+      vector<T> t0(x.span());
+      adjustRanks(t0, a0.ranks, ksOld, kz, 0.0f, float(X)/(Z+1), 1.0f/(Z+1));
+      runEngines(r, p, pe, x, xt, x, xt, t0, c0.ranks, Dz, ReducedUpdate<G, DiGraphCsr<int>>(), first);
+      // Restore original graph, for the next batch (not measured).
+      updateBatchOmp(x, xt, bz);
+    }
+  }
+  return ok;
+}
+
+
+
+
+// RUN-STREAM
+// ----------
+// Temporal edges are parsed a batch ahead, on a producer thread, while ranks
+// of the current batch are updated. Graph grows in place; dynamic engines
+// find affected vertices from changed vertices, so no old copy is needed.
+
+struct StreamBatch {
+  vector<pair<int, int>> edges;  // sorted
+  size_t read = 0;               // edges read
+  float  time = 0;               // to read, on producer thread
+};
+
+
+// Write top (k) ranks of vertices (ks), all if k=0.
+template <class T>
+void writeRanks(FILE *f, const vector<T>& a, vector<int> ks, int k, int step) {
+  size_t n = k>0? min(size_t(k), ks.size()) : ks.size();
+  partial_sort(ks.begin(), ks.begin()+n, ks.end(), [&](int u, int v) { return a[u] > a[v]; });
+  for (size_t i=0; i<n; i++)
+    fprintf(f, "%d,%zu,%d,%.6e\n", step, i+1, ks[i], a[ks[i]]);
+  fflush(f);
+}
+
+
+bool runStream(Record r, const Options& p, const PerfEvents& pe, bool& first) {
+  using G = DiGraph<>;
+  using T = float;
+  const string& e = p.engines[0];
+  const string& m = p.modes[0];
+  int    t = p.threads[0];
+  size_t N = p.batches[0];
+  bool seq = e.find("Seq")  != string::npos;
+  bool cw  = e.find("wise") != string::npos;  // needs components
+  G x; DiGraph<int> xt; PagerankData<G> D; vector<T> a0;
+  PagerankOptions<T> o(1, p.norm);
+  o.numThreads = seq? 1 : t;
+  o.schedule   = p.schedule; o.chunkSize = p.chunk;
+  PagerankResult<T> a;
+  if (!runEngine(a, e, m, x, xt, x, xt, &a0, o, D)) { fprintf(stderr, "Engine %s (%s) not supported\n", e.c_str(), m.c_str()); return false; }
+  ifstream fs; bool in = strcmp(p.file, "-")==0;
+  if (!in) fs.open(p.file);
+  istream& s = in? cin : fs;
+  if (!s) { fprintf(stderr, "Cannot open %s\n", p.file); return false; }
+  FILE *fr = p.ranks? fopen(p.ranks, "w") : nullptr;
+  if (p.ranks && !fr) { fprintf(stderr, "Cannot open ranks %s\n", p.ranks); return false; }
+  if (fr) fprintf(fr, "step,position,vertex,rank\n");
+  size_t M = 0; int step = 0;
+  r.update = 'I';
+  float tt = measureDuration([&] {
+    pipelineBatches<StreamBatch>([&](StreamBatch& b) {
+      b.time = measureDuration([&] { b.read = readSnapTemporalBatch(b.edges, s, N); });
+      return b.read>0;
+    }, [&](StreamBatch& b, float tw) {
+      r.order = x.order(); r.size  = x.size();
+      r.batch = int(b.read); r.step = step;
+      writePhase(r, "parse", b.time, p, first);
+      writePhase(r, "wait",  tw, p, first);
+      // New vertices start at 1/(Y+1), others are scaled, as in adjustRanks().
+      vector<int> vs, cv;
+      for (const auto& [u, v] : b.edges) {
+        if (!x.hasVertex(u)) vs.push_back(u);
+        if (!x.hasVertex(v)) vs.push_back(v);
+      }
+      int X = x.order(); float tb = tw;
+      tb += measurePhase(r, "update", p, first, [&] { cv = updateBatchOmp(x, xt, {}, b.edges); });
+      if (cw) tb += measurePhase(r, "components", p, first, [&] { D = step==0? pagerankDataOmp(x, xt) : pagerankDataOmp(D, x, xt, decltype(b.edges)(), b.edges); });
+      D.changedVertices = cv;
+      int Y = x.order();
+      vector<T> q(x.span());
+      for (size_t u=0; u<a0.size(); u++)
+        q[u] = a0[u] * (float(X)/(Y+1));
+      for (int u : vs)
+        q[u] = 1.0f/(Y+1);
+      // Update ranks, with graph as both old and new.
+      Record rs = r; PerfCounts c;
+      tb += measureDuration([&] { c = measurePerf(pe, [&] { runEngine(a, e, m, x, xt, x, xt, &q, o, D); }); });
+      rs.order = x.order(); rs.size = x.size();
+      rs.engine = e; rs.mode = m;
+      rs.threads = seq? 1 : t>0? t : omp_get_max_threads();
+      rs.iterations = a.iterations;
+      rs.error = NAN;  // no reference
+      rs.perf  = c;
+      writePhase(rs, "solve", a.time, p, first);
+      a0 = move(a.ranks);
+      if (fr) tb += measurePhase(r, "ranks", p, first, [&] { writeRanks(fr, a0, vertices(x), p.top, step); });
+      rs.throughput = b.read / (tb/1000);
+      writePhase(rs, "batch", tb, p, first);
+      M += b.read; step++;
+    });
+  });
+  if (fr) fclose(fr);
+  r.order = x.order(); r.size = x.size();
+  r.batch = int(N); r.step = step;
+  r.throughput = M / (tt/1000);
+  writePhase(r, "stream", tt, p, first);
+  fprintf(stderr, "Streamed %zu edges in %d batches, %.1f edges/s\n", M, step, r.throughput);
+  return true;
+}
+
+
+int main(int argc, char **argv) {
+  auto p = readOptions(argc, argv);
+  if (p.help || !p.error.empty()) {
+    if (!p.error.empty()) fprintf(stderr, "%s\n", p.error.c_str());
+    printHelp(argv[0]);
+    return p.help? 0 : 1;
+  }
+  setScheduleOmp(p.schedule, p.chunk);  // for loading, and graph operations
+  // Open counters before graph is loaded, on as many threads as used.
+  PerfEvents pe;
+  if (p.perf) pe = openPerfEvents(max(omp_get_max_threads(), *max_element(p.threads.begin(), p.threads.end())));
+  if (p.perf && !hasPerfEvents(pe)) fprintf(stderr, "Cannot open perf events, counters are -1\n");
+  if (p.output) p.out = fopen(p.output, "w");
+  if (!p.out) { fprintf(stderr, "Cannot open output %s\n", p.output); return 1; }
+  Record r; bool first = true, ok = true;
+  DiGraph<> x;
+  r.graph = p.file;
+  if (p.temporal) ok = runStream(r, p, pe, first);
+  else {
+    fprintf(stderr, "Loading graph %s ...\n", p.file);
+    measurePhase(r, "load", p, first, [&] { x = readMtxOmp(p.file, p.cache, [](float) {}); });
+    r.order = x.order(); r.size = x.size();
+    ok = runBenchmark(x, r, p, pe, first);
+  }
+  if (p.json) fprintf(p.out, "%s]\n", first? "[" : "\n");
+  if (p.output) fclose(p.out);
+  closePerfEvents(pe);
+  return ok? 0 : 1;
+}
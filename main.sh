@@ -1,7 +1,6 @@
 #!/usr/bin/env bash
 src="kitchen-sink"
 out="/home/resources/Documents/subhajit/$src.log"
-ulimit -s unlimited
 printf "" > "$out"
 
 # Download program
@@ -10,9 +9,15 @@ git clone https://github.com/puzzlef/$src
 cd $src
 
 # Run
-nvcc -std=c++17 -Xcompiler -fopenmp -lnvgraph -O3 main.cu
+nvcc -std=c++17 -Xcompiler -fopenmp,-march=native -lnvgraph -O3 main.cu
 stdbuf --output=L ./a.out ~/data/webbase-2001.mtx    2>&1 | tee -a "$out"
 stdbuf --output=L ./a.out ~/data/indochina-2004.mtx  2>&1 | tee -a "$out"
 stdbuf --output=L ./a.out ~/data/arabic-2005.mtx     2>&1 | tee -a "$out"
 stdbuf --output=L ./a.out ~/data/GAP-twitter.mtx     2>&1 | tee -a "$out"
 stdbuf --output=L ./a.out ~/data/GAP-road.mtx        2>&1 | tee -a "$out"
+
+# Run (CPU only, records in CSV)
+# g++ -std=c++17 -fopenmp -march=native -O3 -o bench main.cxx
+# ./bench -b 1e3,1e4 -t 1,8,32 --perf -o "$src.csv" ~/data/webbase-2001.mtx
+# ./bench -e MonolithicOmp,MonolithicOmpFrontier -b 1e3 --reduce -o "$src-reduce.csv" ~/data/webbase-2001.mtx
+# ./bench --temporal -b 1e5 --ranks "$src-ranks.csv" -k 100 -o "$src-stream.csv" ~/data/sx-stackoverflow.txt
@@ -67,6 +67,14 @@ class DiGraph {
     edata.clear();
   }
 
+  // Make room for vertices [0, n), rather than growing one vertex at a time.
+  void respan(int n) {
+    if (n <= span()) return;
+    vex.resize(n);
+    vdata.resize(n);
+    edata.resize(n);
+  }
+
   void addVertex(int u, V d=V()) {
     if (hasVertex(u)) return;
     if (u >= span()) {
@@ -119,6 +127,41 @@ class DiGraph {
     vex[u] = false;
     N--;
   }
+
+  // Remove a vertex known to have no in-edges from others, without
+  // scanning every vertex for them (as removeVertex() does).
+  void removeIsolatedVertex(int u) {
+    if (!hasVertex(u)) return;
+    removeEdges(u);
+    vex[u] = false;
+    N--;
+  }
+
+  // Edge updates of a vertex without size tracking, safe in parallel
+  // for distinct (u). Size is to be adjusted with addSize() afterwards.
+  bool addEdgeUnsized(int u, int v, E d=E()) {
+    if (!hasVertex(u) || !hasVertex(v) || edata[u].has(v)) return false;
+    edata[u].addChecked(v, d);
+    return true;
+  }
+
+  bool removeEdgeUnsized(int u, int v) {
+    if (!hasEdge(u, v)) return false;
+    edata[u].remove(v);
+    return true;
+  }
+
+  // Replace out-edges of a vertex with sorted, distinct ones (vs).
+  template <class I>
+  void setEdgesUnsized(int u, const I& vs) {
+    edata[u].clear();
+    for (int v : vs)
+      edata[u].add(v);
+  }
+
+  void addSize(int n) {
+    M += n;
+  }
 };
 
 
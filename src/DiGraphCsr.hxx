@@ -0,0 +1,231 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <algorithm>
+#include "_main.hxx"
+
+using std::vector;
+using std::ostream;
+using std::move;
+using std::sort;
+using std::unique;
+using std::binary_search;
+
+
+
+
+// DI-GRAPH-CSR
+// ------------
+// Read-only graph with flat offsets and indices (CSR).
+// Vertices are stored from the first vertex id (base), so that the
+// offsets and indices are 0-based, and can be passed to kernels as-is.
+
+template <class V=NONE, class E=NONE>
+class DiGraphCsr {
+  public:
+  using TVertex = V;
+  using TEdge   = E;
+
+  private:
+  vector<char>   vex;
+  vector<V>      vdata;
+  vector<size_t> vfrom;
+  vector<int>    efrom;
+  int B = 0, N = 0;
+
+  // Cute helpers
+  private:
+  size_t ebegin(int u) const { return u>=B && u<span()? vfrom[u-B]   : 0; }
+  size_t eend(int u)   const { return u>=B && u<span()? vfrom[u-B+1] : 0; }
+
+  // Read operations
+  public:
+  int span()  const { return vex.size(); }
+  int order() const { return N; }
+  int size()  const { return efrom.size(); }
+  int base()  const { return B; }
+
+  bool hasVertex(int u) const { return u < span() && vex[u]; }
+  bool hasEdge(int u, int v) const {
+    auto ib = efrom.begin()+ebegin(u), ie = efrom.begin()+eend(u);
+    return binary_search(ib, ie, v-B);
+  }
+  auto edges(int u) const {
+    auto es = cpointerIter(efrom.data()+ebegin(u), efrom.data()+eend(u));
+    return transformIter(es, [=](int v) { return v+B; });
+  }
+  int degree(int u)  const { return int(eend(u) - ebegin(u)); }
+  auto vertices()    const { return filterIter(rangeIter(span()), [&](int u) { return  vex[u]; }); }
+  auto nonVertices() const { return filterIter(rangeIter(span()), [&](int u) { return !vex[u]; }); }
+
+  V vertexData(int u)   const { return hasVertex(u)? vdata[u-B] : V(); }
+  void setVertexData(int u, V d) { if (hasVertex(u)) vdata[u-B] = d; }
+  E edgeData(int u, int v) const { return E(); }
+
+  // Read as CSR (0-based, from base)
+  public:
+  const vector<size_t>& sourceOffsets()      const { return vfrom; }
+  const vector<int>&    destinationIndices() const { return efrom; }
+  const vector<V>&      vertexValues()       const { return vdata; }
+
+  // Write operations
+  public:
+  void clear() {
+    vex.clear();
+    vdata.clear();
+    vfrom.clear();
+    efrom.clear();
+    B = N = 0;
+  }
+
+  // Take ownership of CSR (offsets, indices) of vertices [base, span).
+  // Vertex flags (ex) mark holes, all vertices exist if empty.
+  DiGraphCsr() {}
+  DiGraphCsr(int base, vector<size_t>&& offsets, vector<int>&& indices, vector<char>&& ex={}, vector<V>&& values={}) :
+  vdata(move(values)), vfrom(move(offsets)), efrom(move(indices)), B(base) {
+    int S = B + int(vfrom.size()) - 1;
+    vdata.resize(S-B);
+    vex.resize(S);
+    for (int u=B; u<S; u++)
+      vex[u] = ex.empty() || ex[u-B];
+    N = countIf(rangeIter(S), [&](int u) { return vex[u]; });
+  }
+};
+
+
+
+
+// DI-GRAPH-CSR FROM EDGES
+// -----------------------
+// Edge lists (es) hold 0-based pairs (from, to), one list per chunk.
+
+template <class J>
+void csrDegreesOmp(vector<int>& a, const J& es, bool sym) {
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t i=0; i<es.size(); i++) {
+    const auto& e = es[i];
+    for (size_t j=0; j<e.size(); j+=2) {
+      #pragma omp atomic
+      a[e[j]]++;
+      if (!sym) continue;
+      #pragma omp atomic
+      a[e[j+1]]++;
+    }
+  }
+}
+
+template <class J>
+void csrIndicesOmp(vector<int>& a, vector<size_t>& cur, const J& es, bool sym) {
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t i=0; i<es.size(); i++) {
+    const auto& e = es[i]; size_t k;
+    for (size_t j=0; j<e.size(); j+=2) {
+      #pragma omp atomic capture
+      k = cur[e[j]]++;
+      a[k] = e[j+1];
+      if (!sym) continue;
+      #pragma omp atomic capture
+      k = cur[e[j+1]]++;
+      a[k] = e[j];
+    }
+  }
+}
+
+void csrOffsets(vector<size_t>& a, const vector<int>& degs) {
+  size_t i = 0; int S = degs.size();
+  a.resize(S+1);
+  for (int u=0; u<S; u++) {
+    a[u] = i;
+    i += degs[u];
+  }
+  a[S] = i;
+}
+
+
+template <class J>
+auto digraphCsrFromEdgesOmp(int base, int n, const J& es, bool sym=false) {
+  vector<int> degs(n);
+  vector<size_t> vfrom, cur;
+  // Bucket edges by source vertex.
+  csrDegreesOmp(degs, es, sym);
+  csrOffsets(vfrom, degs);
+  vector<int> efrom(vfrom[n]); cur = vfrom;
+  csrIndicesOmp(efrom, cur, es, sym);
+  // Sort edges of each vertex, and drop duplicates.
+  #pragma omp parallel for schedule(runtime)
+  for (int u=0; u<n; u++) {
+    auto ib = efrom.begin()+vfrom[u], ie = efrom.begin()+vfrom[u+1];
+    sort(ib, ie);
+    degs[u] = unique(ib, ie) - ib;
+  }
+  // Compact edges if duplicates were dropped.
+  if (size_t(sum(degs, size_t())) == efrom.size())
+    return DiGraphCsr<>(base, move(vfrom), move(efrom));
+  csrOffsets(cur, degs);
+  vector<int> efrum(cur[n]);
+  #pragma omp parallel for schedule(runtime)
+  for (int u=0; u<n; u++)
+    copy(efrom.begin()+vfrom[u], efrom.begin()+vfrom[u]+degs[u], efrum.begin()+cur[u]);
+  return DiGraphCsr<>(base, move(cur), move(efrum));
+}
+
+
+
+
+// DI-GRAPH-CSR FROM GRAPH
+// -----------------------
+// Flatten a graph (with sorted edges) into CSR, from its first vertex.
+
+template <class G>
+auto digraphCsrOmp(const G& x) {
+  using V = typename G::TVertex;
+  using E = typename G::TEdge;
+  int S = x.span(), B = 0;
+  while (B<S && !x.hasVertex(B)) B++;
+  vector<size_t> vfrom(S-B+1);
+  vector<char>   ex(S-B);
+  vector<V>      vdata(S-B);
+  size_t i = 0;
+  for (int u=B; u<S; u++) {
+    vfrom[u-B] = i;
+    ex[u-B]    = x.hasVertex(u);
+    vdata[u-B] = x.vertexData(u);
+    i += x.degree(u);
+  }
+  vfrom[S-B] = i;
+  vector<int> efrom(i);
+  #pragma omp parallel for schedule(runtime)
+  for (int u=B; u<S; u++) {
+    size_t j = vfrom[u-B];
+    for (int v : x.edges(u))
+      efrom[j++] = v-B;
+  }
+  return DiGraphCsr<V, E>(B, move(vfrom), move(efrom), move(ex), move(vdata));
+}
+
+
+
+
+// DI-GRAPH-CSR PRINT
+// ------------------
+
+template <class V, class E>
+void write(ostream& a, const DiGraphCsr<V, E>& x, bool all=false) {
+  a << "order: " << x.order() << " size: " << x.size();
+  if (!all) { a << " {}"; return; }
+  a << " {\n";
+  for (int u : x.vertices()) {
+    a << "  " << u << " ->";
+    for (int v : x.edges(u))
+      a << " " << v;
+    a << "\n";
+  }
+  a << "}";
+}
+
+template <class V, class E>
+ostream& operator<<(ostream& a, const DiGraphCsr<V, E>& x) {
+  write(a, x);
+  return a;
+}
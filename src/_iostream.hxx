@@ -6,6 +6,10 @@
 #include <fstream>
 #include <iostream>
 #include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using std::pair;
 using std::string;
@@ -34,6 +38,53 @@ string readFile(const char *pth) {
 
 
 
+// MAP-FILE
+// --------
+// Map a file into memory for reading (read-only).
+
+struct MappedFile {
+  const char *data = nullptr;
+  size_t size = 0;
+  int fd = -1;
+};
+
+
+MappedFile mapFile(const char *pth) {
+  MappedFile a; struct stat s;
+  a.fd = open(pth, O_RDONLY);
+  if (a.fd<0) return a;
+  if (fstat(a.fd, &s)<0 || s.st_size==0) return a;
+  void *p = mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, a.fd, 0);
+  if (p==MAP_FAILED) return a;
+  madvise(p, s.st_size, MADV_SEQUENTIAL);
+  a.data = (const char*) p;
+  a.size = s.st_size;
+  return a;
+}
+
+void unmapFile(MappedFile& a) {
+  if (a.data) munmap((void*) a.data, a.size);
+  if (a.fd>=0) close(a.fd);
+  a = MappedFile();
+}
+
+
+
+
+// FILE-NEWER
+// ----------
+// Is file (x) present, and modified after file (y)?
+
+bool fileNewer(const char *x, const char *y) {
+  struct stat sx, sy;
+  if (stat(x, &sx)<0) return false;
+  if (stat(y, &sy)<0) return true;
+  return sx.st_mtime >= sy.st_mtime;
+}
+
+
+
+
 // WRITE
 // -----
 
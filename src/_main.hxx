@@ -2,11 +2,15 @@
 #include "_algorithm.hxx"
 #include "_cmath.hxx"
 #include "_ctypes.hxx"
-#include "_cuda.hxx"
 #include "_iostream.hxx"
 #include "_iterator.hxx"
-#include "_nvgraph.hxx"
 #include "_openmp.hxx"
+#include "_perf.hxx"
+#include "_pipeline.hxx"
 #include "_string.hxx"
 #include "_utility.hxx"
 #include "_vector.hxx"
+#ifdef __CUDACC__
+#include "_cuda.hxx"
+#include "_nvgraph.hxx"
+#endif
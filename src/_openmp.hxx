@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdlib>
 #include <omp.h>
 
 
@@ -9,3 +10,48 @@
 
 #define SIZE_MIN_OMPM 100000000
 #define SIZE_MIN_OMPR 100000
+
+
+
+
+// THREADS
+// -------
+// Run with given number of threads (0 => OpenMP default, or OMP_NUM_THREADS).
+
+template <class F>
+void withThreadsOmp(int n, F fn) {
+  int n0 = omp_get_max_threads();
+  if (n>0) omp_set_num_threads(n);
+  fn();
+  if (n>0) omp_set_num_threads(n0);
+}
+
+
+
+
+// SCHEDULE
+// --------
+// Vertex and edge loops use schedule(runtime), so their schedule is set in one
+// place: from PagerankOptions, else OMP_SCHEDULE, else dynamic with CHUNK_SIZE.
+// Coarse loops (over file chunks, components, search frontiers) keep their own.
+
+#define CHUNK_SIZE          2048  // vertices/edges per chunk (runtime default)
+#define CHUNK_SIZE_FRONTIER 256   // frontier vertices per chunk
+#define CHUNK_SIZE_COARSE   64    // costly items (components, batch sources) per chunk
+
+
+// Set schedule of runtime loops (kind is omp_sched_t, 0 => default; chunk 0 => CHUNK_SIZE).
+inline void setScheduleOmp(int k=0, int c=0) {
+  if (k==0 && getenv("OMP_SCHEDULE")) return;
+  omp_set_schedule(omp_sched_t(k? k : omp_sched_dynamic), c>0? c : CHUNK_SIZE);
+}
+
+// Run with given schedule of runtime loops, restoring it after.
+template <class F>
+void withScheduleOmp(int k, int c, F fn) {
+  omp_sched_t k0; int c0;
+  omp_get_schedule(&k0, &c0);
+  setScheduleOmp(k, c);
+  fn();
+  omp_set_schedule(k0, c0);
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using std::vector;
+using std::memset;
+
+
+
+
+// PERF-EVENTS
+// -----------
+// Hardware counters of OpenMP threads, through perf_event_open() (Linux).
+// Each thread of the pool opens counters of its own, which are summed up,
+// as inherited counters are only added up when threads exit. Counters that
+// cannot be opened (no permission, no PMU, not Linux) read as -1.
+
+#define PERF_EVENTS 4
+
+struct PerfCounts {
+  int64_t instructions = -1;
+  int64_t cycles = -1;
+  int64_t cacheReferences = -1;
+  int64_t cacheMisses = -1;  // last-level cache
+};
+
+struct PerfEvents {
+  vector<int> fd;  // PERF_EVENTS per thread
+};
+
+
+// Open counters on each of (n) threads (0 => all).
+PerfEvents openPerfEvents(int n=0) {
+  PerfEvents a;
+  if (n<=0) n = omp_get_max_threads();
+  a.fd.resize(n*PERF_EVENTS, -1);
+#ifdef __linux__
+  const uint64_t cs[] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+  #pragma omp parallel num_threads(n)
+  {
+    int t = omp_get_thread_num();
+    for (int i=0; i<PERF_EVENTS; i++) {
+      struct perf_event_attr e;
+      memset(&e, 0, sizeof(e));
+      e.type     = PERF_TYPE_HARDWARE;
+      e.size     = sizeof(e);
+      e.config   = cs[i];
+      e.disabled = 1;
+      e.exclude_kernel = 1;
+      e.exclude_hv     = 1;
+      a.fd[t*PERF_EVENTS+i] = syscall(__NR_perf_event_open, &e, 0, -1, -1, 0);
+    }
+  }
+#endif
+  return a;
+}
+
+void closePerfEvents(PerfEvents& a) {
+#ifdef __linux__
+  for (int f : a.fd)
+    if (f>=0) close(f);
+#endif
+  a = PerfEvents();
+}
+
+bool hasPerfEvents(const PerfEvents& a) {
+  for (int f : a.fd)
+    if (f>=0) return true;
+  return false;
+}
+
+
+void startPerfEvents(const PerfEvents& a) {
+#ifdef __linux__
+  for (int f : a.fd) {
+    if (f<0) continue;
+    ioctl(f, PERF_EVENT_IOC_RESET, 0);
+    ioctl(f, PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+}
+
+PerfCounts stopPerfEvents(const PerfEvents& a) {
+  int64_t vs[PERF_EVENTS] = {-1, -1, -1, -1};
+#ifdef __linux__
+  for (size_t j=0; j<a.fd.size(); j++) {
+    int f = a.fd[j], i = j % PERF_EVENTS; int64_t v;
+    if (f<0) continue;
+    ioctl(f, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(f, &v, sizeof(v)) != sizeof(v)) continue;
+    vs[i] = vs[i]<0? v : vs[i]+v;
+  }
+#endif
+  PerfCounts b;
+  b.instructions    = vs[0];
+  b.cycles          = vs[1];
+  b.cacheReferences = vs[2];
+  b.cacheMisses     = vs[3];
+  return b;
+}
+
+
+// Count events of a function (fn), if events (a) are open.
+template <class F>
+PerfCounts measurePerf(const PerfEvents& a, F fn) {
+  startPerfEvents(a);
+  fn();
+  return stopPerfEvents(a);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include "_utility.hxx"
+
+using std::mutex;
+using std::thread;
+using std::unique_lock;
+using std::lock_guard;
+using std::condition_variable;
+using std::chrono::high_resolution_clock;
+
+
+
+
+// PIPELINE-BATCHES
+// ----------------
+// Double-buffered producer-consumer: a producer thread fills one buffer,
+// while the caller processes the other. At most two batches are held, and
+// buffers are reused, so memory stays bounded however long the stream is.
+
+// @param fr read next batch into buffer (on producer thread), false at end
+// @param fp process batch, given time spent waiting for it (in ms)
+// @returns number of batches processed
+template <class B, class FR, class FP>
+size_t pipelineBatches(FR fr, FP fp) {
+  B    bs[2];
+  bool full[2] = {false, false}, done = false;
+  mutex m; condition_variable cv;
+  thread t([&] {
+    for (size_t i=0;; i++) {
+      int k = i % 2;
+      { unique_lock<mutex> l(m); cv.wait(l, [&] { return !full[k]; }); }
+      bool ok = fr(bs[k]);
+      { lock_guard<mutex> l(m); full[k] = ok; done = !ok; }
+      cv.notify_all();
+      if (!ok) break;
+    }
+  });
+  size_t i = 0;
+  for (;; i++) {
+    int  k = i % 2; bool ok;
+    auto start = high_resolution_clock::now();
+    { unique_lock<mutex> l(m); cv.wait(l, [&] { return full[k] || done; }); ok = full[k]; }
+    auto stop  = high_resolution_clock::now();
+    if (!ok) break;
+    fp(bs[k], durationMilliseconds(start, stop));
+    { lock_guard<mutex> l(m); full[k] = false; }
+    cv.notify_all();
+  }
+  t.join();
+  return i;
+}
@@ -22,3 +22,41 @@ size_t countLines(const char *x) {
 size_t countLines(const string& x) {
   return countLines(x.c_str());
 }
+
+
+
+
+// FIND-NEXT-LINE
+// --------------
+// For splitting text into newline aligned chunks.
+
+const char* findNextLine(const char *ib, const char *ie) {
+  for (; ib<ie; ib++)
+    if (*ib == '\n') return ib+1;
+  return ie;
+}
+
+
+
+
+// READ-INTEGER
+// ------------
+// Parse an integer after blanks (returns end, same as begin if none).
+
+const char* skipBlank(const char *ib, const char *ie) {
+  for (; ib<ie && (*ib==' ' || *ib=='\t' || *ib=='\r'); ib++);
+  return ib;
+}
+
+template <class T>
+const char* readInteger(T& a, const char *ib, const char *ie) {
+  const char *it = skipBlank(ib, ie);
+  bool neg = it<ie && *it=='-';
+  if (it<ie && (*it=='-' || *it=='+')) it++;
+  if (it>=ie || *it<'0' || *it>'9') return ib;
+  T v = 0;
+  for (; it<ie && *it>='0' && *it<='9'; it++)
+    v = v*10 + (*it-'0');
+  a = neg? -v : v;
+  return it;
+}
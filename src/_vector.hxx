@@ -5,6 +5,9 @@
 #include <map>
 #include <algorithm>
 #include <utility>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include "_openmp.hxx"
 
 using std::array;
@@ -16,6 +19,9 @@ using std::move;
 using std::abs;
 using std::max;
 using std::sqrt;
+using std::sort;
+using std::unique;
+using std::remove_if;
 
 
 
@@ -113,6 +119,25 @@ void insertIndex(vector<T>& a, size_t i, size_t n, const T& v) {
 
 
 
+// FILTER
+// ------
+
+template <class T, class F>
+void filterIf(vector<T>& a, F fn) {
+  auto it = remove_if(a.begin(), a.end(), [&](const T& v) { return !fn(v); });
+  a.erase(it, a.end());
+}
+
+
+template <class T>
+void sortUnique(vector<T>& a) {
+  sort(a.begin(), a.end());
+  a.erase(unique(a.begin(), a.end()), a.end());
+}
+
+
+
+
 // APPEND
 // ------
 
@@ -357,7 +382,7 @@ void copy(vector<T>& a, const vector<T>& x, int i, int N) {
 template <class T, class U>
 void copyOmp(T *a, U *x, int N) {
   if (N<SIZE_MIN_OMPM) { copy(a, x, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = x[i];
 }
@@ -398,7 +423,7 @@ void fill(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void fillOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { fill(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = v;
 }
@@ -462,7 +487,7 @@ U sum(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sum(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(+:a)
   for (int i=0; i<N; i++)
     a += x[i];
   return a;
@@ -511,7 +536,7 @@ U sumAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sumAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(+:a)
   for (int i=0; i<N; i++)
     a += abs(x[i]);
   return a;
@@ -554,7 +579,7 @@ U sumSqr(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumSqrOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sumSqr(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(+:a)
   for (int i=0; i<N; i++)
     a += x[i]*x[i];
   return a;
@@ -595,6 +620,42 @@ U sumAt(const vector<T>& x, int i, const J& is, U a=U()) {
 
 
 
+// Sum of x at indices [ib, ie), with AVX-512/AVX2 gathers for float
+// (if enabled at compile time, say with -march=native).
+template <class T, class U=T>
+U sumAtSimd(const T *x, const int *ib, const int *ie, U a=U()) {
+  for (; ib<ie; ++ib)
+    a += x[*ib];
+  return a;
+}
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+inline float sumAtSimd(const float *x, const int *ib, const int *ie, float a=0) {
+#if defined(__AVX512F__)
+  // Gather and extract with zeroed sources; unmasked forms pass an undefined
+  // one, which GCC warns of (-Wmaybe-uninitialized).
+  __m512 z = _mm512_setzero_ps(), s = z;
+  for (; ie-ib>=16; ib+=16)
+    s = _mm512_add_ps(s, _mm512_mask_i32gather_ps(z, 0xFFFF, _mm512_loadu_si512(ib), x, 4));
+  __m512d d = _mm512_castps_pd(s);
+  __m256  h = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, d, 0)), _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, d, 1)));
+#else
+  __m256 h = _mm256_setzero_ps();
+  for (; ie-ib>=8; ib+=8)
+    h = _mm256_add_ps(h, _mm256_i32gather_ps(x, _mm256_loadu_si256((const __m256i*) ib), 4));
+#endif
+  __m128 q = _mm_add_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+  q = _mm_hadd_ps(q, q);
+  q = _mm_hadd_ps(q, q);
+  a += _mm_cvtss_f32(q);
+  for (; ib<ie; ++ib)
+    a += x[*ib];
+  return a;
+}
+#endif
+
+
+
 
 // ADD-VALUE
 // ---------
@@ -619,7 +680,7 @@ void addValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void addValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { addValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] += v;
 }
@@ -683,7 +744,7 @@ U max(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U maxOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return max(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(max:a)
   for (int i=0; i<N; i++)
     a = max(a, x[i]);
   return a;
@@ -726,7 +787,7 @@ U maxAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U maxAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return maxAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(max:a)
   for (int i=0; i<N; i++)
     a = max(a, abs(x[i]));
   return a;
@@ -791,7 +852,7 @@ void maxValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void maxValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { maxValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = max(a[i], v);
 }
@@ -855,7 +916,7 @@ U min(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U minOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return min(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(min:a)
   for (int i=0; i<N; i++)
     a = min(a, x[i]);
   return a;
@@ -898,7 +959,7 @@ U minAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U minAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return minAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(min:a)
   for (int i=0; i<N; i++)
     a = min(a, abs(x[i]));
   return a;
@@ -963,7 +1024,7 @@ void minValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void minValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { minValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = min(a[i], v);
 }
@@ -1027,7 +1088,7 @@ V l1Norm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V l1NormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return l1Norm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(+:a)
   for (int i=0; i<N; i++)
     a += abs(x[i] - y[i]);
   return a;
@@ -1070,7 +1131,7 @@ V l2Norm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V l2NormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return l2Norm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(+:a)
   for (int i=0; i<N; i++)
     a += (x[i] - y[i]) * (x[i] - y[i]);
   return sqrt(a);
@@ -1113,7 +1174,7 @@ V liNorm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V liNormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return liNorm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(runtime) reduction(max:a)
   for (int i=0; i<N; i++)
     a = max(a, abs(x[i] - y[i]));
   return a;
@@ -1155,7 +1216,7 @@ void multiply(vector<T>& a, const vector<U>& x, const vector<V>& y, int i, int N
 template <class T, class U, class V>
 void multiplyOmp(T *a, const U *x, const V *y, int N) {
   if (N<SIZE_MIN_OMPM) { multiply(a, x, y, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = x[i] * y[i];
 }
@@ -1196,7 +1257,7 @@ void multiplyValue(vector<T>& a, const vector<U>& x, const V& v, int i, int N) {
 template <class T, class U, class V>
 void multiplyValueOmp(T *a, const U *x, const V& v, int N) {
   if (N<SIZE_MIN_OMPM) { multiplyValue(a, x, v, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int i=0; i<N; i++)
     a[i] = T(x[i] * v);
 }
@@ -0,0 +1,212 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <random>
+#include <algorithm>
+#include "_main.hxx"
+
+using std::vector;
+using std::pair;
+using std::make_pair;
+using std::uniform_real_distribution;
+using std::lower_bound;
+
+
+
+
+// BATCH
+// -----
+// Edge batch is a list of (from, to) pairs, sorted by source vertex.
+
+// Range of batch with given source vertex [begin, end).
+auto batchRange(const vector<pair<int, int>>& x, int u) {
+  auto fl = [](const auto& e, int u) { return e.first < u; };
+  auto ib = lower_bound(x.begin(), x.end(), u, fl);
+  auto ie = lower_bound(ib, x.end(), u+1, fl);
+  return make_pair(ib, ie);
+}
+
+
+
+
+// RANDOM-BATCH
+// ------------
+
+template <class R>
+auto randomBatch(R& rnd, int span, int N) {
+  uniform_real_distribution<> dis(0.0, 1.0);
+  vector<pair<int, int>> a;
+  for (int i=0; i<N; i++) {
+    int u = int(dis(rnd) * span);
+    int v = int(dis(rnd) * span);
+    a.push_back({u, v});
+  }
+  sortUnique(a);
+  return a;
+}
+
+
+// Random existing edges of a graph, to delete (self-loops are kept).
+template <class R, class G>
+auto randomDeleteBatch(R& rnd, const G& x, int N) {
+  uniform_real_distribution<> dis(0.0, 1.0);
+  vector<pair<int, int>> a;
+  int S = x.span();
+  for (int i=0, t=0; i<N && t<8*N; t++) {
+    int u = int(dis(rnd) * S);
+    int d = x.hasVertex(u)? x.degree(u) : 0;
+    if (d==0) continue;
+    int k = int(dis(rnd) * d), v = u;
+    for (int w : x.edges(u))
+      if (k-- == 0) { v = w; break; }
+    if (v==u) continue;
+    a.push_back({u, v}); i++;
+  }
+  sortUnique(a);
+  return a;
+}
+
+
+
+
+// UPDATE-BATCH
+// ------------
+// Apply sorted batch of edge deletions (del) and insertions (ins) to a graph,
+// and its transpose (with vertex-data=out-degree), in parallel by vertex.
+// Self-loops mark dead ends: a vertex left without edges gets one, and a
+// vertex with only a self-loop loses it when it gains other edges.
+// Cost scales with batch size (and degrees of its vertices), not graph size.
+
+template <class G, class J>
+auto updateEdgesOmp(G& x, const vector<int>& us, const J& del, const J& ins, vector2d<int>& rem, vector2d<int>& add, bool loops) {
+  int U = us.size(), dM = 0;
+  rem.resize(U);
+  add.resize(U);
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE) reduction(+:dM)
+  for (int i=0; i<U; i++) {
+    int  u = us[i];
+    bool dead = loops && x.degree(u)==1 && x.hasEdge(u, u), keep = false;
+    auto [db, de] = batchRange(del, u);
+    auto [ib, ie] = batchRange(ins, u);
+    for (auto it=db; it!=de; ++it)
+      if (x.removeEdgeUnsized(u, (*it).second)) rem[i].push_back((*it).second);
+    for (auto it=ib; it!=ie; ++it) {
+      keep |= (*it).second == u;
+      if (x.addEdgeUnsized(u, (*it).second)) add[i].push_back((*it).second);
+    }
+    if (dead && !keep && x.degree(u)>1 && x.removeEdgeUnsized(u, u)) rem[i].push_back(u);
+    if (loops && x.degree(u)==0 && x.addEdgeUnsized(u, u)) add[i].push_back(u);
+    dM += int(add[i].size()) - int(rem[i].size());
+  }
+  x.addSize(dM);
+}
+
+
+// Flip edges (from us[i], to each of es[i]) into a sorted batch.
+auto flipBatch(const vector<int>& us, const vector2d<int>& es) {
+  vector<pair<int, int>> a;
+  for (int i=0, I=us.size(); i<I; i++) {
+    for (int v : es[i])
+      a.push_back({v, us[i]});
+  }
+  sortUnique(a);
+  return a;
+}
+
+
+// @param x   graph (with dead-end self-loops)
+// @param xt  transpose graph (with vertex-data=out-degree)
+// @param del edges to delete, sorted
+// @param ins edges to insert, sorted
+// @returns changed vertices (with edges added/removed, either way), sorted
+template <class G, class H>
+auto updateBatchOmp(G& x, H& xt, const vector<pair<int, int>>& del, const vector<pair<int, int>>& ins) {
+  // New vertices start as dead ends.
+  vector<int> us;
+  for (const auto& [u, v] : del)
+    us.push_back(u);
+  for (const auto& [u, v] : ins) {
+    for (int w : {u, v}) {
+      if (x.hasVertex(w)) continue;
+      x.addVertex(w); xt.addVertex(w);
+      us.push_back(w);
+    }
+    us.push_back(u);
+  }
+  sortUnique(us);
+  // Update out-edges, and out-degree in transpose.
+  vector2d<int> rem, add;
+  updateEdgesOmp(x, us, del, ins, rem, add, true);
+  #pragma omp parallel for schedule(runtime)
+  for (int i=0; i<int(us.size()); i++)
+    xt.setVertexData(us[i], x.degree(us[i]));
+  // Update in-edges, from the edges actually changed.
+  auto tdel = flipBatch(us, rem);
+  auto tins = flipBatch(us, add);
+  vector<int> vs, a;
+  for (const auto& [v, u] : tdel) vs.push_back(v);
+  for (const auto& [v, u] : tins) vs.push_back(v);
+  sortUnique(vs);
+  vector2d<int> trem, tadd;
+  updateEdgesOmp(xt, vs, tdel, tins, trem, tadd, false);
+  // Changed vertices are the ends of changed edges.
+  for (int i=0, I=us.size(); i<I; i++)
+    if (!rem[i].empty() || !add[i].empty()) a.push_back(us[i]);
+  append(a, vs);
+  sortUnique(a);
+  return a;
+}
+
+
+
+
+// UNDO-BATCH
+// ----------
+// Undo of a batch update, so that a graph can be updated in place and
+// restored, instead of copied: edges the update actually deleted are
+// inserted back, those it actually inserted are deleted, and vertices it
+// added are removed. Self-loops of its sources are kept, as a vertex left
+// with a self-loop alone would otherwise be taken for a dead end.
+
+struct BatchUndo {
+  vector<pair<int, int>> del, ins;
+  vector<int> vertices;  // added by update
+};
+
+
+// Find undo of a batch update (del, ins), on the graph before it.
+template <class G>
+auto undoBatch(const G& x, const vector<pair<int, int>>& del, const vector<pair<int, int>>& ins) {
+  BatchUndo a;
+  for (const auto& [u, v] : del) {
+    if (x.hasEdge(u, v)) a.ins.push_back({u, v});
+    if (x.hasEdge(u, u)) a.ins.push_back({u, u});
+  }
+  for (const auto& [u, v] : ins) {
+    if (!x.hasEdge(u, v)) a.del.push_back({u, v});
+    if (x.hasEdge(u, u))  a.ins.push_back({u, u});
+    for (int w : {u, v})
+      if (!x.hasVertex(w)) a.vertices.push_back(w);
+  }
+  sortUnique(a.del);
+  sortUnique(a.ins);
+  sortUnique(a.vertices);
+  return a;
+}
+
+
+// @param x  graph (with dead-end self-loops), as updated
+// @param xt transpose graph (with vertex-data=out-degree), as updated
+// @param b  undo of update, from undoBatch()
+// @returns changed vertices (that still exist), sorted
+template <class G, class H>
+auto updateBatchOmp(G& x, H& xt, const BatchUndo& b) {
+  auto a = updateBatchOmp(x, xt, b.del, b.ins);
+  // Added vertices are left with a self-loop alone.
+  for (int u : b.vertices) {
+    x.removeIsolatedVertex(u);
+    xt.removeIsolatedVertex(u);
+  }
+  filterIf(a, [&](int u) { return x.hasVertex(u); });
+  return a;
+}
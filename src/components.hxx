@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "_main.hxx"
+#include "DiGraph.hxx"
 #include "vertices.hxx"
 #include "dfs.hxx"
 
@@ -54,7 +55,7 @@ auto componentIds(const G& x, const vector2d<int>& cs) {
 
 // BLOCKGRAPH
 // ----------
-// Each component is represented as a vertex.
+// Each component is represented as a vertex (of a mutable graph).
 
 template <class H, class G>
 void blockgraph(H& a, const G& x, const vector2d<int>& cs) {
@@ -69,7 +70,7 @@ void blockgraph(H& a, const G& x, const vector2d<int>& cs) {
 
 template <class G>
 auto blockgraph(const G& x, const vector2d<int>& cs) {
-  G a; blockgraph(a, x, cs);
+  DiGraph<> a; blockgraph(a, x, cs);
   return a;
 }
 
@@ -0,0 +1,426 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "_main.hxx"
+#include "DiGraph.hxx"
+#include "vertices.hxx"
+#include "dfs.hxx"
+#include "components.hxx"
+#include "sort.hxx"
+
+using std::vector;
+using std::pair;
+using std::move;
+using std::binary_search;
+
+
+
+
+// COMPONENTS-TRIM
+// ---------------
+// Vertices (in ks) with no in/out-edges left are SCCs of their own.
+// Vertices still to be labelled have id -1, others are ignored.
+
+template <class G, class H>
+void componentIdsTrimOmp(vector<int>& a, const G& x, const H& xt, vector<int>& ks) {
+  vector<char> trim(x.span());
+  while (!ks.empty()) {
+    int K = ks.size(), T = 0;
+    #pragma omp parallel for schedule(runtime) reduction(+:T)
+    for (int i=0; i<K; i++) {
+      int u = ks[i]; bool o = false, n = false;
+      for (int v : x.edges(u))
+        if (v!=u && a[v]==-1) { o = true; break; }
+      for (int v : xt.edges(u))
+        if (v!=u && a[v]==-1) { n = true; break; }
+      trim[u] = !o || !n; T += trim[u];
+    }
+    for (int u : ks)
+      if (trim[u]) a[u] = u;
+    filterIf(ks, [&](int u) { return !trim[u]; });
+    if (T <= K/64) break;  // long chains are left to dfs
+  }
+}
+
+
+
+
+// COMPONENTS-REACH
+// ----------------
+// Level-synchronous BFS from vertex u, among vertices to be labelled.
+
+template <class G>
+void componentIdsReachOmp(vector<char>& vis, const vector<int>& a, const G& x, int u) {
+  vector<int> frnt {u}, frnu;
+  vis[u] = 1;
+  while (!frnt.empty()) {
+    frnu.clear();
+    #pragma omp parallel
+    {
+      vector<int> buf;
+      #pragma omp for schedule(dynamic, CHUNK_SIZE_FRONTIER) nowait
+      for (size_t i=0; i<frnt.size(); i++) {
+        for (int v : x.edges(frnt[i])) {
+          if (a[v]!=-1 || vis[v]) continue;
+          char w;
+          #pragma omp atomic capture
+          { w = vis[v]; vis[v] = 1; }
+          if (!w) buf.push_back(v);
+        }
+      }
+      #pragma omp critical
+      append(frnu, buf);
+    }
+    swap(frnt, frnu);
+  }
+}
+
+
+
+
+// COMPONENT-IDS (PARALLEL)
+// ------------------------
+// Label SCCs of vertices ks (with id -1) by their representative vertex.
+// Multistep: trim trivial SCCs, forward-backward BFS from a high degree
+// pivot for the giant SCC, and Kosaraju on what remains.
+
+template <class G, class H>
+void componentIdsOmpW(vector<int>& a, const G& x, const H& xt, vector<int> ks) {
+  componentIdsTrimOmp(a, x, xt, ks);
+  if (ks.empty()) return;
+  // Forward-backward from pivot.
+  int p = ks[0];
+  for (int u : ks)
+    if (size_t(x.degree(u))*xt.degree(u) > size_t(x.degree(p))*xt.degree(p)) p = u;
+  vector<char> fw(x.span()), bw(x.span());
+  componentIdsReachOmp(fw, a, x,  p);
+  componentIdsReachOmp(bw, a, xt, p);
+  int K = ks.size();
+  #pragma omp parallel for schedule(runtime)
+  for (int i=0; i<K; i++) {
+    int u = ks[i];
+    if (fw[u] && bw[u]) a[u] = p;
+  }
+  filterIf(ks, [&](int u) { return a[u]==-1; });
+  componentIdsTrimOmp(a, x, xt, ks);
+  if (ks.empty()) return;
+  // Kosaraju on the rest, with labelled vertices marked as visited.
+  vector<int> vs;
+  vector<bool> vis(x.span(), true);
+  for (int u : ks) vis[u] = false;
+  for (int u : ks)
+    if (!vis[u]) dfsEndLoop(vs, vis, x, u);
+  for (int u : ks) vis[u] = false;
+  while (!vs.empty()) {
+    int u = vs.back(); vs.pop_back();
+    if (vis[u]) continue;
+    dfsDoLoop(vis, xt, u, [&](int v) { a[v] = u; });
+  }
+}
+
+
+
+
+// COMPONENTS-GROUP
+// ----------------
+// Group vertices (ks) by their representative vertex (a).
+
+template <class J>
+auto componentsGroup(const vector<int>& a, const J& ks) {
+  vector2d<int> cs;
+  vector<int> is(a.size(), -1);
+  for (int u : ks) {
+    int p = a[u];
+    if (is[p]<0) { is[p] = cs.size(); cs.push_back(vector<int>()); }
+    cs[is[p]].push_back(u);
+  }
+  return cs;
+}
+
+
+
+
+// COMPONENT-IDS-OMP
+// -----------------
+
+template <class G>
+auto componentIdsOmp(const G& x, const vector2d<int>& cs) {
+  vector<int> a(x.span(), -1);
+  int C = cs.size();
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+  for (int i=0; i<C; i++) {
+    for (int u : cs[i])
+      a[u] = i;
+  }
+  return a;
+}
+
+
+
+
+// BLOCKGRAPH-OMP
+// --------------
+
+template <class H, class G>
+void blockgraphOmp(H& a, const G& x, const vector2d<int>& cs, const vector<int>& c) {
+  int C = cs.size();
+  vector2d<int> es(C);
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+  for (int i=0; i<C; i++) {
+    for (int u : cs[i]) {
+      for (int v : x.edges(u))
+        if (c[v]!=i) es[i].push_back(c[v]);
+    }
+    sortUnique(es[i]);
+  }
+  for (int i=0; i<C; i++) {
+    a.addVertex(i);
+    for (int j : es[i])
+      a.addEdge(i, j);
+  }
+  a.correct();
+}
+
+template <class G>
+auto blockgraphOmp(const G& x, const vector2d<int>& cs) {
+  DiGraph<> a; blockgraphOmp(a, x, cs, componentIdsOmp(x, cs));
+  return a;
+}
+
+
+
+
+// TOPOLOGICAL-BLOCKGRAPH
+// ----------------------
+// Reorder components in topological order, and renumber the blockgraph.
+
+template <class G>
+void topologicalComponentsBlockgraphTo(vector2d<int>& cs, G& b) {
+  auto bks = topologicalSort(b);
+  int  C   = bks.size();
+  vector<int> pos(b.span());
+  for (int i=0; i<C; i++)
+    pos[bks[i]] = i;
+  vector2d<int> ds(C);
+  G a;
+  for (int i=0; i<C; i++) {
+    ds[i] = move(cs[bks[i]]);
+    a.addVertex(i);
+    for (int j : b.edges(bks[i]))
+      a.addEdge(i, pos[j]);
+  }
+  a.correct();
+  cs = move(ds);
+  b  = move(a);
+}
+
+
+
+
+// COMPONENTS (PARALLEL)
+// ---------------------
+// Components in topological order, along with their blockgraph.
+
+template <class G, class H>
+auto componentsBlockgraphOmp(const G& x, const H& xt) {
+  vector<int> a(x.span(), -1);
+  auto ks = vertices(x);
+  componentIdsOmpW(a, x, xt, ks);
+  auto cs = componentsGroup(a, ks);
+  DiGraph<> b; blockgraphOmp(b, x, cs, componentIdsOmp(x, cs));
+  topologicalComponentsBlockgraphTo(cs, b);
+  return make_pair(cs, b);
+}
+
+template <class G, class H>
+auto componentsOmp(const G& x, const H& xt) {
+  return componentsBlockgraphOmp(x, xt).first;
+}
+
+
+
+
+// COMPONENTS (DYNAMIC)
+// --------------------
+// Update components (cs) and blockgraph (b, bt) of a graph, after an edge
+// batch (del, ins) took it to (y, yt). Components on a blockgraph cycle
+// formed by inserted edges are merged (on the blockgraph alone), and those
+// with an edge deleted within are split (along with the cycle, if any).
+// Block edges leaving a component with a deleted edge to another are found
+// again from its vertices first, so that a lost block edge is not followed.
+// Only the SCC search is limited to affected components; component ids,
+// blockgraph, and its topological order are still rebuilt in full, in
+// O(N + C + blockgraph size). This avoids the O(M) search of
+// componentsBlockgraphOmp(), but is not proportional to batch size.
+
+template <class B, class FK, class F>
+void blockgraphReachDo(vector<bool>& vis, const B& b, const vector2d<int>& ex, const vector<int>& ks, FK fk, F fn) {
+  vector<int> s;
+  for (int i : ks)
+    if (!vis[i]) { vis[i] = true; s.push_back(i); }
+  while (!s.empty()) {
+    int i = s.back(); s.pop_back(); fn(i);
+    for (int j : b.edges(i))
+      if (!vis[j] && fk(i, j)) { vis[j] = true; s.push_back(j); }
+    for (int j : ex[i])
+      if (!vis[j]) { vis[j] = true; s.push_back(j); }
+  }
+}
+
+
+// Merge components on cycles among rs, as groups of component indices.
+template <class B, class FK>
+auto blockgraphMergeGroups(const B& b, const vector2d<int>& ex, const vector<int>& rs, FK fk) {
+  DiGraph<> r;
+  for (int i : rs)
+    r.addVertex(i);
+  for (int i : rs) {
+    for (int j : b.edges(i))
+      if (r.hasVertex(j) && fk(i, j)) r.addEdge(i, j);
+    for (int j : ex[i])
+      if (r.hasVertex(j)) r.addEdge(i, j);
+  }
+  r.correct();
+  auto gs = components(r, transpose(r));
+  filterIf(gs, [](const auto& g) { return g.size()>1; });
+  return gs;
+}
+
+
+template <class B, class G, class H, class J>
+auto componentsBlockgraphUpdateOmp(const vector2d<int>& cs, const B& b, const B& bt, const G& y, const H& yt, const J& del, const J& ins) {
+  int  C = cs.size();
+  auto c = componentIdsOmp(y, cs);
+  // New vertices stand as components of their own, for now.
+  vector<int> us;
+  for (const auto& [u, v] : ins) {
+    for (int w : {u, v})
+      if (y.hasVertex(w) && c[w]==-1) { c[w] = C + us.size(); us.push_back(w); }
+  }
+  int  D = C + us.size();
+  auto members = [&](int i) { return i<C? cs[i] : vector<int> {us[i-C]}; };
+  // Deletions within a component may split it, others may drop a block edge.
+  vector<bool> aff(D), dirty(D);
+  bool split = false;
+  for (const auto& [u, v] : del) {
+    if (!y.hasVertex(u) || !y.hasVertex(v) || y.hasEdge(u, v)) continue;
+    if (c[u]==c[v]) aff[c[u]] = split = true;
+    else dirty[c[u]] = true;
+  }
+  // Block edges of dirty components may be gone, keep only those still present.
+  vector<int> ds;
+  for (int i=0; i<C; i++)
+    if (dirty[i]) ds.push_back(i);
+  vector2d<int> bd(D);
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+  for (size_t k=0; k<ds.size(); k++) {
+    int i = ds[k];
+    for (int u : cs[i])
+      for (int v : y.edges(u))
+        if (c[v]!=i) bd[i].push_back(c[v]);
+    sortUnique(bd[i]);
+  }
+  auto fk = [&](int i, int j) { return !dirty[i] || binary_search(bd[i].begin(), bd[i].end(), j); };
+  // Insertions across components may merge those on a cycle.
+  vector2d<int> exf(D), exb(D);
+  vector<int> ss, ts, rs;
+  for (const auto& [u, v] : ins) {
+    if (!y.hasEdge(u, v) || c[u]==c[v]) continue;
+    exf[c[u]].push_back(c[v]); ss.push_back(c[u]);
+    exb[c[v]].push_back(c[u]); ts.push_back(c[v]);
+  }
+  vector<bool> fw(D), bw(D);
+  blockgraphReachDo(fw, b,  exf, ts, fk, [](int i) {});
+  blockgraphReachDo(bw, bt, exb, ss, [&](int i, int j) { return fk(j, i); }, [&](int i) { if (fw[i]) rs.push_back(i); });
+  // New components: merged on blockgraph, or split by relabelling vertices.
+  vector2d<int> es;
+  if (!split) {
+    for (const auto& g : blockgraphMergeGroups(b, exf, rs, fk)) {
+      es.push_back(vector<int>());
+      for (int i : g) {
+        aff[i] = true;
+        append(es.back(), members(i));
+      }
+    }
+  }
+  else {
+    vector<int> ks;
+    for (int i : rs) aff[i] = true;
+    for (int i=0; i<D; i++)
+      if (aff[i]) append(ks, members(i));  // new vertices on a cycle too
+    for (int u : ks) c[u] = -1;
+    componentIdsOmpW(c, y, yt, ks);
+    es = componentsGroup(c, ks);
+  }
+  for (int i=C; i<D; i++)
+    if (!aff[i]) { aff[i] = true; es.push_back({us[i-C]}); }
+  // Keep unaffected components, and add new ones at the end.
+  vector2d<int> a;
+  vector<int> ids(D, -1);
+  for (int i=0; i<C; i++)
+    if (!aff[i]) { ids[i] = a.size(); a.push_back(cs[i]); }
+  int A = a.size();
+  for (auto& e : es)
+    a.push_back(move(e));
+  int E = a.size();
+  // Vertices of new components are marked with new id, offset by D.
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+  for (int i=A; i<E; i++) {
+    for (int u : a[i])
+      c[u] = D + i;
+  }
+  if (!split) {
+    for (int i=0; i<D; i++)
+      if (aff[i]) ids[i] = c[members(i)[0]] - D;
+  }
+  auto ci = [&](int u) { return c[u]>=D? c[u]-D : ids[c[u]]; };
+  // Carry over block edges of old components, unless split.
+  // Rescan out-edges where block edges may be lost (or components split).
+  vector2d<int> bs(C), bo(E), bi(E);
+  #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+  for (int i=0; i<C; i++) {
+    if (split && aff[i]) continue;
+    int k = ids[i];
+    if (dirty[i]) {
+      for (int u : cs[i])
+        for (int v : y.edges(u))
+          if (ci(v)!=k) bs[i].push_back(ci(v));
+    }
+    else {
+      for (int j : b.edges(i))
+        if (ids[j]>=0 && ids[j]!=k) bs[i].push_back(ids[j]);
+    }
+  }
+  if (split) {
+    #pragma omp parallel for schedule(dynamic, CHUNK_SIZE_COARSE)
+    for (int i=A; i<E; i++) {
+      for (int u : a[i]) {
+        for (int v : y.edges(u))
+          if (ci(v)!=i) bo[i].push_back(ci(v));
+        for (int v : yt.edges(u))
+          if (ci(v)<A) bi[i].push_back(ci(v));
+      }
+    }
+  }
+  DiGraph<> d;
+  for (int i=0; i<E; i++)
+    d.addVertex(i);
+  for (int i=0; i<C; i++) {
+    for (int j : bs[i])
+      d.addEdge(ids[i], j);
+  }
+  for (int i=A; i<E; i++) {
+    for (int j : bo[i])
+      d.addEdge(i, j);
+    for (int j : bi[i])
+      d.addEdge(j, i);
+  }
+  for (const auto& [u, v] : ins) {
+    if (!y.hasEdge(u, v) || ci(u)==ci(v)) continue;
+    d.addEdge(ci(u), ci(v));
+  }
+  d.correct();
+  topologicalComponentsBlockgraphTo(a, d);
+  return make_pair(a, d);
+}
@@ -47,3 +47,26 @@ auto copy(const G& x) {
   G a; copyTo(a, x);
   return a;
 }
+
+
+
+
+// COPY (OPENMP)
+// -------------
+// Copy into a DiGraph, in parallel by vertex. Edges of each vertex are
+// already sorted, so they are set as a whole, without correct().
+
+template <class H, class G>
+void copyToOmp(H& a, const G& x) {
+  int S = x.span(), dM = 0;
+  a.respan(S);
+  for (int u : x.vertices())
+    a.addVertex(u, x.vertexData(u));
+  #pragma omp parallel for schedule(runtime) reduction(+:dM)
+  for (int u=0; u<S; u++) {
+    if (!x.hasVertex(u)) continue;
+    dM += x.degree(u) - a.degree(u);
+    a.setEdgesUnsized(u, x.edges(u));
+  }
+  a.addSize(dM);
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <algorithm>
 #include "_main.hxx"
+#include "DiGraphCsr.hxx"
 
 using std::vector;
 using std::transform;
@@ -65,3 +66,91 @@ template <class G>
 auto destinationIndices(const G& x) {
   return destinationIndices(x, x.vertices());
 }
+
+
+
+
+// DESTINATION-INDICES (OPENMP)
+// ----------------------------
+// Renumber edges to vertex order (ks), using flat indices.
+
+template <class G, class J>
+auto destinationIndicesOmp(const G& x, const J& ks) {
+  vector<int> ids(x.span());
+  vector<int> kv(ks.begin(), ks.end()); int K = kv.size();
+  auto vfrom = sourceOffsets(x, kv);
+  for (int i=0; i<K; i++)
+    ids[kv[i]] = i;
+  vector<int> a(vfrom[K]);
+  #pragma omp parallel for schedule(runtime)
+  for (int i=0; i<K; i++) {
+    size_t j = vfrom[i];
+    for (int v : x.edges(kv[i]))
+      a[j++] = ids[v];
+  }
+  return a;
+}
+
+
+
+
+// CSR (REUSE)
+// -----------
+// Use CSR of a flat graph as-is, if vertex order (ks) matches.
+// Otherwise CSR is built into (a).
+
+template <class G, class J>
+bool csrMatches(const G& x, const J& ks) {
+  return false;
+}
+
+template <class V, class E, class J>
+bool csrMatches(const DiGraphCsr<V, E>& x, const J& ks) {
+  int u = x.base();
+  if (x.order() != x.span()-u || int(ks.size()) != x.order()) return false;
+  for (int k : ks)
+    if (k != u++) return false;
+  return true;
+}
+
+
+template <class G, class J>
+const vector<size_t>& sourceOffsetsTo(vector<size_t>& a, const G& x, const J& ks) {
+  a = sourceOffsets(x, ks);
+  return a;
+}
+
+template <class V, class E, class J>
+const vector<size_t>& sourceOffsetsTo(vector<size_t>& a, const DiGraphCsr<V, E>& x, const J& ks) {
+  if (csrMatches(x, ks)) return x.sourceOffsets();
+  a = sourceOffsets(x, ks);
+  return a;
+}
+
+
+template <class G, class J>
+const vector<int>& destinationIndicesTo(vector<int>& a, const G& x, const J& ks) {
+  a = destinationIndices(x, ks);
+  return a;
+}
+
+template <class V, class E, class J>
+const vector<int>& destinationIndicesTo(vector<int>& a, const DiGraphCsr<V, E>& x, const J& ks) {
+  if (csrMatches(x, ks)) return x.destinationIndices();
+  a = destinationIndicesOmp(x, ks);
+  return a;
+}
+
+
+template <class G, class J, class V>
+const vector<V>& vertexDataTo(vector<V>& a, const G& x, const J& ks) {
+  a = vertexData(x, ks);
+  return a;
+}
+
+template <class V, class E, class J>
+const vector<V>& vertexDataTo(vector<V>& a, const DiGraphCsr<V, E>& x, const J& ks) {
+  if (csrMatches(x, ks)) return x.vertexValues();
+  a = vertexData(x, ks);
+  return a;
+}
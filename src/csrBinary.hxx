@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include "_main.hxx"
+#include "DiGraphCsr.hxx"
+
+using std::vector;
+using std::ofstream;
+using std::ifstream;
+using std::ios;
+using std::memcmp;
+using std::memcpy;
+
+
+
+
+// CSR-BINARY
+// ----------
+// On-disk CSR, stored flat so that it loads with a few bulk reads (no parsing):
+// header, vertex flags (padded to 8 bytes), offsets (64-bit), indices (32-bit).
+
+#define CSR_BINARY_MAGIC "KSCSR001"
+
+struct CsrBinaryHeader {
+  char    magic[8];
+  int64_t base, span, order, size;
+};
+
+
+size_t csrBinaryFlagsSize(size_t n) {
+  return (n+7) & ~size_t(7);
+}
+
+
+
+
+// WRITE-CSR-BINARY
+// ----------------
+
+template <class G>
+bool writeCsrBinary(const char *pth, const G& x) {
+  int B = x.base(), S = x.span(), n = S-B;
+  const auto& vfrom = x.sourceOffsets();
+  const auto& efrom = x.destinationIndices();
+  CsrBinaryHeader h;
+  memcpy(h.magic, CSR_BINARY_MAGIC, 8);
+  h.base = B; h.span = S; h.order = x.order(); h.size = x.size();
+  vector<char> ex(csrBinaryFlagsSize(n));
+  for (int u=B; u<S; u++)
+    ex[u-B] = x.hasVertex(u);
+  ofstream f(pth, ios::binary);
+  f.write((const char*) &h, sizeof(h));
+  f.write(ex.data(), ex.size());
+  f.write((const char*) vfrom.data(), vfrom.size()*sizeof(size_t));
+  f.write((const char*) efrom.data(), efrom.size()*sizeof(int));
+  return bool(f);
+}
+
+
+
+
+// READ-CSR-BINARY
+// ---------------
+
+bool readCsrBinary(DiGraphCsr<>& a, const char *pth) {
+  ifstream f(pth, ios::binary | ios::ate);
+  CsrBinaryHeader h;
+  size_t fs = f? size_t(f.tellg()) : 0;
+  f.seekg(0);
+  bool ok = fs >= sizeof(h) && f.read((char*) &h, sizeof(h));
+  ok = ok && memcmp(h.magic, CSR_BINARY_MAGIC, 8)==0;
+  size_t n  = ok? h.span-h.base : 0;
+  size_t ne = csrBinaryFlagsSize(n);
+  size_t nf = (n+1) * sizeof(size_t);
+  size_t ni = ok? h.size * sizeof(int) : 0;
+  ok = ok && fs == sizeof(h) + ne + nf + ni;
+  if (!ok) return false;
+  // read straight into vectors of graph
+  vector<char>   ex(ne);
+  vector<size_t> vfrom(n+1);
+  vector<int>    efrom(h.size);
+  f.read(ex.data(), ne);
+  f.read((char*) vfrom.data(), nf);
+  f.read((char*) efrom.data(), ni);
+  if (!f) return false;
+  ex.resize(n);
+  a = DiGraphCsr<>(int(h.base), move(vfrom), move(efrom), move(ex));
+  return true;
+}
@@ -1,10 +1,49 @@
 #pragma once
 #include <utility>
 #include <vector>
+#include <tuple>
 #include "vertices.hxx"
 
 using std::pair;
 using std::vector;
+using std::tuple;
+using std::declval;
+
+
+
+
+// DFS-STACK
+// ---------
+// Explicit stack of (vertex, depth, next edge, end edge), so that deep
+// graphs do not overflow the call stack. Visit order matches recursion.
+
+template <class G>
+using DfsFrame = tuple<int, int, decltype(declval<const G&>().edges(0).begin()), decltype(declval<const G&>().edges(0).end())>;
+
+template <class G>
+void dfsPush(vector<DfsFrame<G>>& s, const G& x, int u, int d) {
+  auto es = x.edges(u);
+  s.push_back({u, d, es.begin(), es.end()});
+}
+
+
+// Calls fe(u, d) on entry, and fx(u) on exit.
+template <class G, class FE, class FX>
+void dfsStackDoLoop(vector<bool>& vis, const G& x, int u, int d, FE fe, FX fx) {
+  if (vis[u]) return;  // dont visit if done already!
+  vector<DfsFrame<G>> s;
+  vis[u] = true; fe(u, d);
+  dfsPush(s, x, u, d);
+  while (!s.empty()) {
+    auto& [w, dw, it, ie] = s.back();
+    if (it == ie) { fx(w); s.pop_back(); continue; }
+    int v = *it; ++it;
+    if (vis[v]) continue;
+    int dv = dw+1;
+    vis[v] = true; fe(v, dv);
+    dfsPush(s, x, v, dv);
+  }
+}
 
 
 
@@ -15,10 +54,7 @@ using std::vector;
 
 template <class G, class F>
 void dfsDoLoop(vector<bool>& vis, const G& x, int u, F fn) {
-  if (vis[u]) return;  // dont visit if done already!
-  vis[u] = true; fn(u);
-  for (int v : x.edges(u))
-    if (!vis[v]) dfsDoLoop(vis, x, v, fn);
+  dfsStackDoLoop(vis, x, u, 0, [&](int v, int d) { fn(v); }, [](int v) {});
 }
 
 template <class G, class F>
@@ -50,11 +86,7 @@ auto dfs(const G& x, int u) {
 
 template <class G, class F>
 void dfsEndDoLoop(vector<bool>& vis, const G& x, int u, F fn) {
-  if (vis[u]) return;  // dont visit if done already!
-  vis[u] = true;
-  for (int v : x.edges(u))
-    if (!vis[v]) dfsEndDoLoop(vis, x, v, fn);
-  fn(u);
+  dfsStackDoLoop(vis, x, u, 0, [](int v, int d) {}, fn);
 }
 
 template <class G, class F>
@@ -86,10 +118,7 @@ auto dfsEnd(const G& x, int u) {
 
 template <class G, class F>
 void dfsDepthDoLoop(vector<bool>& vis, const G& x, int u, int d, F fn) {
-  if (vis[u]) return;  // dont visit if done already!
-  vis[u] = true; fn(u, d++);
-  for (int v : x.edges(u))
-    if (!vis[v]) dfsDepthDoLoop(vis, x, v, d, fn);
+  dfsStackDoLoop(vis, x, u, d, fn, [](int v) {});
 }
 
 template <class G, class F>
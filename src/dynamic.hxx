@@ -101,6 +101,21 @@ auto affectedVertices(const G& x, const H& xt, const G& y, const H& yt) {
 }
 
 
+// From known changed vertices (ks), such as those of a batch update.
+template <class G, class J, class F>
+void affectedVerticesFromForEach(const G& y, const J& ks, F fn) {
+  auto vis = createContainer(y, bool());
+  for (int u : ks)
+    if (y.hasVertex(u)) dfsDoLoop(vis, y, u, fn);
+}
+
+template <class G, class J>
+auto affectedVerticesFrom(const G& y, const J& ks) {
+  vector<int> a; affectedVerticesFromForEach(y, ks, [&](int u) { a.push_back(u); });
+  return a;
+}
+
+
 
 
 // DYNAMIC-VERTICES
@@ -131,6 +146,13 @@ auto dynamicVertices(const G& x, const H& xt, const G& y, const H& yt) {
   });
 }
 
+template <class G, class J>
+auto dynamicVerticesFrom(const G& y, const J& ks) {
+  return dynamicVerticesBy(y, [&](auto fn) {
+    affectedVerticesFromForEach(y, ks, fn);
+  });
+}
+
 
 
 
@@ -163,6 +185,18 @@ auto changedComponentIndices(const G& x, const H& xt, const G& y, const H& yt, c
 }
 
 
+// Components holding known changed vertices (ks).
+template <class G, class J, class F>
+void changedComponentIndicesFromForEach(const G& y, const vector2d<int>& cs, const J& ks, F fn) {
+  auto c = componentIds(y, cs);
+  vector<bool> vis(cs.size());
+  for (int u : ks) {
+    if (!y.hasVertex(u) || vis[c[u]]) continue;
+    vis[c[u]] = true; fn(c[u]);
+  }
+}
+
+
 
 
 // AFFECTED-COMPONENTS
@@ -181,6 +215,12 @@ void affectedComponentIndicesForEach(const G& x, const H& xt, const G& y, const
   changedComponentIndicesForEach(x, xt, y, yt, cs, [&](int u) { dfsDoLoop(vis, b, u, fn); });
 }
 
+template <class G, class B, class J, class F>
+void affectedComponentIndicesFromForEach(const G& y, const vector2d<int>& cs, const B& b, const J& ks, F fn) {
+  auto vis = createContainer(b, bool());
+  changedComponentIndicesFromForEach(y, cs, ks, [&](int i) { dfsDoLoop(vis, b, i, fn); });
+}
+
 template <class G, class B>
 auto affectedComponentIndices(const G& x, const G& y, const vector2d<int>& cs, const B& b) {
   vector<int> a; affectedComponentIndicesForEach(x, y, cs, b, [&](int u) { a.push_back(u); });
@@ -223,3 +263,10 @@ auto dynamicComponentIndices(const G& x, const H& xt, const G& y, const H& yt, c
     affectedComponentIndicesForEach(x, xt, y, yt, cs, b, fn);
   });
 }
+
+template <class G, class B, class J>
+auto dynamicComponentIndicesFrom(const G& y, const vector2d<int>& cs, const B& b, const J& ks) {
+  return dynamicComponentIndicesBy(y, cs, [&](auto fn) {
+    affectedComponentIndicesFromForEach(y, cs, b, ks, fn);
+  });
+}
@@ -20,7 +20,10 @@ auto edgeIdenticalsFromSize(const G& x, const J& ks, int n) {
   map<vec, vec> m; vec es;
   // Find groups of identicals.
   for (int u : ks) {
-    write(es, x.edges(u)); sort(es);
+    es.clear();
+    for (int v : x.edges(u))
+      es.push_back(v);
+    sort(es);
     m[es].push_back(u);
   }
   // Copy identicals from given size in sorted order.
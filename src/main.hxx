@@ -1,30 +1,37 @@
 #pragma once
 #include "_main.hxx"
 #include "DiGraph.hxx"
+#include "DiGraphCsr.hxx"
 #include "vertices.hxx"
 #include "edges.hxx"
 #include "csr.hxx"
 #include "snap.hxx"
+#include "csrBinary.hxx"
 #include "mtx.hxx"
+#include "batch.hxx"
 #include "copy.hxx"
 #include "transpose.hxx"
 #include "deadEnds.hxx"
 #include "selfLoop.hxx"
 #include "components.hxx"
 #include "sort.hxx"
+#include "componentsOmp.hxx"
 #include "identicals.hxx"
 #include "dynamic.hxx"
 #include "pagerank.hxx"
 #include "pagerankSeq.hxx"
 #include "pagerankOmp.hxx"
-#include "pagerankCuda.hxx"
-#include "pagerankNvgraph.hxx"
 #include "pagerankMonolithicSeq.hxx"
 #include "pagerankMonolithicOmp.hxx"
-#include "pagerankMonolithicCuda.hxx"
 #include "pagerankComponentwiseSeq.hxx"
 #include "pagerankComponentwiseOmp.hxx"
-#include "pagerankComponentwiseCuda.hxx"
 #include "pagerankLevelwiseSeq.hxx"
 #include "pagerankLevelwiseOmp.hxx"
+#include "pagerankReduce.hxx"
+#ifdef __CUDACC__
+#include "pagerankCuda.hxx"
+#include "pagerankNvgraph.hxx"
+#include "pagerankMonolithicCuda.hxx"
+#include "pagerankComponentwiseCuda.hxx"
 #include "pagerankLevelwiseCuda.hxx"
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdio>
 #include <string>
 #include <istream>
 #include <sstream>
@@ -6,6 +7,9 @@
 #include <algorithm>
 #include "_main.hxx"
 #include "DiGraph.hxx"
+#include "DiGraphCsr.hxx"
+#include "csrBinary.hxx"
+#include "copy.hxx"
 
 using std::string;
 using std::istream;
@@ -13,6 +17,7 @@ using std::stringstream;
 using std::ofstream;
 using std::getline;
 using std::max;
+using std::min;
 
 
 
@@ -80,6 +85,127 @@ auto readMtx(const char *pth, FS fs) {
 
 
 
+// READ-MTX (OPENMP)
+// -----------------
+// Parse memory-mapped file in newline-aligned chunks, in parallel.
+
+#define READ_MTX_CHUNK 4194304
+
+bool readMtxHeader(const char*& ib, const char *ie, bool& sym, int& r, int& c, size_t& sz) {
+  string h0, h1, h2, h3, h4;
+  // read header
+  while (ib<ie && *ib=='%') {
+    const char *il = findNextLine(ib, ie);
+    if (il-ib>=2 && ib[1]=='%') {
+      stringstream ls(string(ib, il));
+      ls >> h0 >> h1 >> h2 >> h3 >> h4;
+    }
+    ib = il;
+  }
+  if (h1!="matrix" || h2!="coordinate") return false;
+  sym = h4=="symmetric" || h4=="skew-symmetric";
+  // read rows, cols, size
+  const char *ir = readInteger(r,  ib, ie);
+  const char *ic = readInteger(c,  ir, ie);
+  const char *is = readInteger(sz, ic, ie);
+  if (ir==ib || ic==ir || is==ic) return false;
+  ib = findNextLine(is, ie);
+  return true;
+}
+
+
+void readMtxChunk(vector<int>& a, const char *ib, const char *ie, int n) {
+  while (ib<ie) {
+    int u, v;
+    const char *il = findNextLine(ib, ie);
+    const char *iu = readInteger(u, ib, il);
+    const char *iv = readInteger(v, iu, il);
+    bool bad = iu==ib || iv==iu;  // blank/bad line
+    ib = il;
+    if (bad) continue;
+    if (u<1 || u>n || v<1 || v>n) continue;
+    a.push_back(u-1);
+    a.push_back(v-1);
+  }
+}
+
+
+template <class FS>
+bool readMtxCsrOmp(DiGraphCsr<>& a, const char *pth, FS fs) {
+  auto m = mapFile(pth);
+  const char *ib = m.data, *ie = m.data + m.size;
+  bool sym; int r, c; size_t sz;
+  if (!m.data || !readMtxHeader(ib, ie, sym, r, c, sz)) { unmapFile(m); return false; }
+  int n = max(r, c);
+  // split into chunks on newline boundaries
+  vector<const char*> cs {ib};
+  while (cs.back()<ie)
+    cs.push_back(findNextLine(cs.back() + min(size_t(ie-cs.back()), size_t(READ_MTX_CHUNK)), ie));
+  // read edges (from, to) of each chunk
+  int C = cs.size()-1, done = 0;
+  vector2d<int> es(C);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int i=0; i<C; i++) {
+    int d;
+    readMtxChunk(es[i], cs[i], cs[i+1], n);
+    #pragma omp atomic capture
+    d = ++done;
+    if (omp_get_thread_num()==0) fs(d/float(C));
+  }
+  unmapFile(m);
+  a = digraphCsrFromEdgesOmp(1, n, es, sym);
+  return true;
+}
+
+template <class FS>
+auto readMtxCsrOmp(const char *pth, FS fs) {
+  DiGraphCsr<> a; readMtxCsrOmp(a, pth, fs);
+  return a;
+}
+
+
+// Use binary CSR cache, if not older than file (else create it).
+// A cache that cannot be written is removed, rather than left partial.
+template <class FS>
+bool readMtxCsrOmp(DiGraphCsr<>& a, const char *pth, const char *cache, FS fs) {
+  if (cache && fileNewer(cache, pth) && readCsrBinary(a, cache)) return true;
+  if (!readMtxCsrOmp(a, pth, fs)) return false;
+  if (cache && !writeCsrBinary(cache, a)) {
+    fprintf(stderr, "Cannot write CSR cache %s\n", cache);
+    remove(cache);
+  }
+  return true;
+}
+
+template <class FS>
+auto readMtxCsrOmp(const char *pth, const char *cache, FS fs) {
+  DiGraphCsr<> a; readMtxCsrOmp(a, pth, cache, fs);
+  return a;
+}
+
+
+template <class G, class FS>
+bool readMtxOmp(G& a, const char *pth, const char *cache, FS fs) {
+  DiGraphCsr<> x;
+  if (!readMtxCsrOmp(x, pth, cache, fs)) return false;
+  copyToOmp(a, x);
+  return true;
+}
+
+template <class FS>
+auto readMtxOmp(const char *pth, const char *cache, FS fs) {
+  DiGraph<> a; readMtxOmp(a, pth, cache, fs);
+  return a;
+}
+
+template <class FS>
+auto readMtxOmp(const char *pth, FS fs) {
+  return readMtxOmp(pth, nullptr, fs);
+}
+
+
+
+
 // WRITE-MTX
 // ---------
 
@@ -2,6 +2,11 @@
 #include <vector>
 #include <utility>
 #include "_main.hxx"
+#include "DiGraph.hxx"
+#include "transpose.hxx"
+#include "components.hxx"
+#include "componentsOmp.hxx"
+#include "dynamic.hxx"
 
 using std::vector;
 using std::move;
@@ -12,6 +17,7 @@ using std::move;
 // LAUNCH CONFIG
 // -------------
 
+#ifdef __CUDACC__
 // For pagerank cuda block-per-vertex
 template <class T=float>
 constexpr int BLOCK_DIM_PRCB() noexcept { return 256; }
@@ -31,6 +37,7 @@ template <class T=float>
 constexpr int BLOCK_DIM_PRCT_HIGHDEGREE() noexcept { return 32; }
 template <class T=float>
 constexpr int GRID_DIM_PRCT_HIGHDEGREE()  noexcept { return 8192; }
+#endif
 
 
 
@@ -65,12 +72,25 @@ struct PagerankOptions {
   T    damping;
   T    tolerance;
   int  maxIterations;
-
-  PagerankOptions(int repeat=1, int toleranceNorm=1, int minCompute=1, bool splitComponents=false, T damping=0.85, T tolerance=1e-6, int maxIterations=500) :
-  repeat(repeat), toleranceNorm(toleranceNorm), minCompute(minCompute), splitComponents(splitComponents), damping(damping), tolerance(tolerance), maxIterations(maxIterations) {}
+  T    frontierTolerance;  // rank change to expand frontier, or skip vertex (0 => tolerance/N)
+  int  numThreads;         // OpenMP threads (0 => default, or OMP_NUM_THREADS)
+  bool asynchronous;       // update ranks in place (fused loop)
+  int  skipCheck;          // skip converged vertices, re-check every n iterations (<=1 => never skip)
+  int  schedule;           // OpenMP schedule of runtime loops, omp_sched_t (0 => OMP_SCHEDULE, or dynamic)
+  int  chunkSize;          // chunk size of runtime loops (0 => CHUNK_SIZE)
+
+  PagerankOptions(int repeat=1, int toleranceNorm=1, int minCompute=1, bool splitComponents=false, T damping=0.85, T tolerance=1e-6, int maxIterations=500, T frontierTolerance=0, int numThreads=0, bool asynchronous=false, int skipCheck=0, int schedule=0, int chunkSize=0) :
+  repeat(repeat), toleranceNorm(toleranceNorm), minCompute(minCompute), splitComponents(splitComponents), damping(damping), tolerance(tolerance), maxIterations(maxIterations), frontierTolerance(frontierTolerance), numThreads(numThreads), asynchronous(asynchronous), skipCheck(skipCheck), schedule(schedule), chunkSize(chunkSize) {}
 };
 
 
+// Run with threads, and schedule of runtime loops, of options.
+template <class T, class F>
+void withOptionsOmp(const PagerankOptions<T>& o, F fn) {
+  withThreadsOmp(o.numThreads, [&] { withScheduleOmp(o.schedule, o.chunkSize, fn); });
+}
+
+
 
 
 // PAGERANK-RESULT
@@ -82,6 +102,9 @@ struct PagerankResult {
   int   iterations;
   float time;
 
+  PagerankResult() :
+  ranks(), iterations(0), time(0) {}
+
   PagerankResult(vector<T>&& ranks, int iterations=0, float time=0) :
   ranks(ranks), iterations(iterations), time(time) {}
 
@@ -108,18 +131,43 @@ struct PagerankResult {
 
 template <class G>
 struct PagerankData {
-  G blockgraph;
-  G blockgraphTranspose;
+  DiGraph<> blockgraph;
+  DiGraph<> blockgraphTranspose;
   vector2d<int> components;
+  vector<int> changedVertices;  // from batch update (optional)
 };
 
+template <class G, class H>
+auto pagerankData(const G& x, const H& xt) {
+  auto cs = components(x, xt);
+  auto b  = blockgraph(x, cs);
+  auto bt = transpose(b);
+  return PagerankData<G> {move(b), move(bt), move(cs), {}};
+}
+
+template <class G, class H>
+auto pagerankDataOmp(const G& x, const H& xt) {
+  auto [cs, b] = componentsBlockgraphOmp(x, xt);
+  auto bt = transpose(b);
+  return PagerankData<G> {move(b), move(bt), move(cs), {}};
+}
+
+// Update data of a graph, after an edge batch (del, ins) took it to (y, yt).
+// SCCs are searched for in affected components only, see componentsBlockgraphUpdateOmp().
+template <class G, class H, class J>
+auto pagerankDataOmp(const PagerankData<G>& D, const G& y, const H& yt, const J& del, const J& ins) {
+  auto [cs, b] = componentsBlockgraphUpdateOmp(D.components, D.blockgraph, D.blockgraphTranspose, y, yt, del, ins);
+  auto bt = transpose(b);
+  return PagerankData<G> {move(b), move(bt), move(cs), {}};
+}
+
 template <class G>
 auto blockgraphD(const G& x, const vector2d<int>& cs, const PagerankData<G> *D) {
   return D? D->blockgraph : blockgraph(x, cs);
 }
 
-template <class G>
-auto blockgraphTransposeD(const G& b, const PagerankData<G> *D) {
+template <class B, class G>
+auto blockgraphTransposeD(const B& b, const PagerankData<G> *D) {
   return D? D->blockgraphTranspose : transpose(b);
 }
 
@@ -127,3 +175,23 @@ template <class G, class H>
 auto componentsD(const G& x, const H& xt, const PagerankData<G> *D) {
   return D? D->components : components(x, xt);
 }
+
+
+// Use changed vertices of batch update, if available.
+template <class G, class H>
+auto dynamicVerticesD(const G& x, const H& xt, const G& y, const H& yt, const PagerankData<G> *D) {
+  if (D && !D->changedVertices.empty()) return dynamicVerticesFrom(y, D->changedVertices);
+  return dynamicVertices(x, xt, y, yt);
+}
+
+template <class G, class B>
+auto dynamicComponentIndicesD(const G& x, const G& y, const vector2d<int>& cs, const B& b, const PagerankData<G> *D) {
+  if (D && !D->changedVertices.empty()) return dynamicComponentIndicesFrom(y, cs, b, D->changedVertices);
+  return dynamicComponentIndices(x, y, cs, b);
+}
+
+template <class G, class H, class B>
+auto dynamicComponentIndicesD(const G& x, const H& xt, const G& y, const H& yt, const vector2d<int>& cs, const B& b, const PagerankData<G> *D) {
+  if (D && !D->changedVertices.empty()) return dynamicComponentIndicesFrom(y, cs, b, D->changedVertices);
+  return dynamicComponentIndices(x, xt, y, yt, cs, b);
+}
@@ -65,9 +65,7 @@ PagerankResult<T> pagerankComponentwiseCuda(const G& x, const H& xt, const vecto
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseCuda(const G& x, const H& xt, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
-  auto cs = components(x, xt);
-  auto b  = blockgraph(x, cs);
-  return pagerankComponentwiseCuda(x, xt, q, o, PagerankData<G>(cs, b));
+  return pagerankComponentwiseCuda(x, xt, q, o, pagerankData(x, xt));
 }
 template <class G, class T=float>
 PagerankResult<T> pagerankComponentwiseCuda(const G& x, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
@@ -87,7 +85,7 @@ PagerankResult<T> pagerankComponentwiseCudaDynamic(const G& x, const H& xt, cons
   const auto& b  = D.blockgraph;
   int  N  = yt.order();                                 if (N==0) return PagerankResult<T>::initial(yt, q);
   auto ds = topologicalComponentsFrom(cs, b);
-  auto [is, n] = dynamicComponentIndices(x, y, ds, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  auto [is, n] = dynamicComponentIndicesD(x, y, ds, b, &D);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto gs = joinAtUntilSize<int>(ds, sliceIter(is, 0, n), o.minCompute);
   forEach(gs, [&](auto& g) { pagerankPartition(yt, g); });
   auto ns = pagerankPairWave(yt, gs);
@@ -96,9 +94,7 @@ PagerankResult<T> pagerankComponentwiseCudaDynamic(const G& x, const H& xt, cons
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseCudaDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
-  auto cs = components(y, yt);
-  auto b  = blockgraph(y, cs);
-  return pagerankComponentwiseCudaDynamic(x, xt, y, yt, q, o, PagerankData<G>(cs, b));
+  return pagerankComponentwiseCudaDynamic(x, xt, y, yt, q, o, pagerankData(y, yt));
 }
 template <class G, class T=float>
 PagerankResult<T> pagerankComponentwiseCudaDynamic(const G& x, const G& y, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
@@ -61,9 +61,7 @@ PagerankResult<T> pagerankComponentwiseOmp(const G& x, const H& xt, const vector
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseOmp(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}) {
-  auto cs = components(x, xt);
-  auto b  = blockgraph(x, cs);
-  return pagerankComponentwiseOmp(x, xt, q, o, PagerankData<G>(cs, b));
+  return pagerankComponentwiseOmp(x, xt, q, o, pagerankData(x, xt));
 }
 template <class G, class T=float>
 PagerankResult<T> pagerankComponentwiseOmp(const G& x, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
@@ -83,7 +81,7 @@ PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const H& xt, const
   const auto& b  = D.blockgraph;
   int  N  = yt.order();                                 if (N==0) return PagerankResult<T>::initial(yt, q);
   auto ds = topologicalComponentsFrom(cs, b);
-  auto [is, n] = dynamicComponentIndices(x, y, ds, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  auto [is, n] = dynamicComponentIndicesD(x, y, ds, b, &D);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto gs = joinAtUntilSize<int>(ds, sliceIter(is, 0, n), o.minCompute);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
   auto ks = join<int>(gs); joinAt(ks, ds, sliceIter(is, n));
@@ -91,9 +89,7 @@ PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const H& xt, const
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}) {
-  auto cs = components(y, yt);
-  auto b  = blockgraph(y, cs);
-  return pagerankComponentwiseOmpDynamic(x, xt, y, yt, q, o, PagerankData<G>(cs, b));
+  return pagerankComponentwiseOmpDynamic(x, xt, y, yt, q, o, pagerankData(y, yt));
 }
 template <class G, class T=float>
 PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const G& y, const vector<T> *q=nullptr, PagerankOptions<T> o={}) {
@@ -254,9 +254,10 @@ PagerankResult<T> pagerankCuda(const H& xt, const J& ks, int i, const M& ns, FL
   int  L  = o.maxIterations, l = 0;
   int  EF = o.toleranceNorm;
   int  R  = reduceSizeCu<T>(N);
-  auto vfrom = sourceOffsets(xt, ks);
-  auto efrom = destinationIndices(xt, ks);
-  auto vdata = vertexData(xt, ks);
+  vector<size_t> vfrom0; vector<int> efrom0, vdata0;
+  const auto& vfrom = sourceOffsetsTo(vfrom0, xt, ks);     // reuse CSR of flat graph,
+  const auto& efrom = destinationIndicesTo(efrom0, xt, ks);  // if vertex order matches
+  const auto& vdata = vertexDataTo(vdata0, xt, ks);
   size_t VFROM1 = vfrom.size() * sizeof(size_t);
   size_t EFROM1 = efrom.size() * sizeof(int);
   size_t VDATA1 = vdata.size() * sizeof(int);
@@ -59,7 +59,7 @@ PagerankResult<T> pagerankLevelwiseOmpDynamic(const G& x, const H& xt, const G&
   const auto& b  = blockgraphD(y, cs, D);
   const auto& bt = blockgraphTransposeD(b, D);
   auto gi = levelwiseGroupIndices(b, bt);
-  auto [is, n] = dynamicComponentIndices(x, y, cs, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  auto [is, n] = dynamicComponentIndicesD(x, y, cs, b, D);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
   auto gs = joinAt2d<int>(cs, ig);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
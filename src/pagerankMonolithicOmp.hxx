@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include "_main.hxx"
 #include "transpose.hxx"
 #include "dynamic.hxx"
@@ -9,6 +10,10 @@
 
 using std::vector;
 using std::swap;
+using std::max;
+using std::abs;
+using std::sqrt;
+using std::iota;
 
 
 
@@ -74,3 +79,249 @@ PagerankResult<T> pagerankMonolithicOmpDynamic(const G& x, const G& y, const vec
   auto yt = transposeWithDegree(y);
   return pagerankMonolithicOmpDynamic(x, xt, y, yt, q, o, D);
 }
+
+
+
+
+// PAGERANK-FUSED-LOOP
+// -------------------
+// Rank, contribution, and error of each vertex are found in a single pass,
+// with one parallel region per iteration. Synchronous mode double-buffers
+// contributions (c, r) instead of ranks, and asynchronous mode updates them
+// in place (Gauss-Seidel), so that vertices see ranks of this iteration.
+// With skip check (S), vertices changing by at most F are marked converged,
+// and skipped until all are re-checked, every S iterations (S<=1 => never).
+// Skipping saves work per iteration, but may take more iterations. Tolerance is
+// only trusted on a full iteration, so a converged-looking one forces a check.
+
+template <bool ASYNC, class T>
+int pagerankFusedOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const vector<size_t>& vfrom, const vector<int>& efrom, int i, int n, int N, T p, T E, int L, int EF, int S, T F) {
+  T  c0 = (1-p)/N;
+  int l = 0, lc = 0;
+  vector<char> cf(S>1? N : 0);
+  if (!ASYNC) copyOmp(r, c);  // vertices outside [i, i+n) keep contributions
+  while (l<L) {
+    vector<T>& cn = ASYNC? c : r;
+    const int *e = efrom.data();
+    bool check = S<=1 || l==lc;
+    T e1 = T(), e2 = T(), ei = T();
+    #pragma omp parallel for schedule(runtime) reduction(+:e1,e2) reduction(max:ei)
+    for (int v=i; v<i+n; v++) {
+      if (!check && cf[v]) { if (!ASYNC) cn[v] = c[v]; continue; }
+      T av = c0 + sumAtSimd(c.data(), e+vfrom[v], e+vfrom[v+1]);
+      T ev = abs(av - a[v]);
+      a[v] = av; cn[v] = av * f[v];
+      if (S>1) cf[v] = ev <= F;
+      e1 += ev; e2 += ev*ev; ei = max(ei, ev);
+    }
+    T el = EF==1? e1 : EF==2? sqrt(e2) : ei; ++l;  // one iteration complete
+    if (!ASYNC) swap(c, r);                        // new contributions in (c)
+    if (el<E && check) break;                      // check tolerance
+    if (check) lc = l-1 + S;                       // next check, S iterations after this one
+    if (el<E)  lc = l;                             // re-check skipped vertices
+  }
+  return l;
+}
+
+
+
+
+// PAGERANK (FUSED)
+// ----------------
+
+template <class H, class J, class T>
+PagerankResult<T> pagerankFusedOmp(const H& xt, const J& ks, int n, const vector<T> *q, const PagerankOptions<T>& o) {
+  int S = o.skipCheck;
+  T   F = o.frontierTolerance>0? o.frontierTolerance : o.tolerance/xt.order();
+  auto fs = [&](auto&&... args) { return pagerankFusedOmpLoop<false>(args..., S, F); };
+  auto fa = [&](auto&&... args) { return pagerankFusedOmpLoop<true> (args..., S, F); };
+  if (o.asynchronous) return pagerankOmp(xt, ks, 0, n, fa, q, o, false);  // no previous ranks (r)
+  return pagerankOmp(xt, ks, 0, n, fs, q, o);
+}
+
+
+// Find pagerank with fused iterations, accelerated with OpenMP (pull, CSR).
+// @param x  original graph
+// @param xt transpose graph (with vertex-data=out-degree)
+// @param q  initial ranks (optional)
+// @param o  options {damping=0.85, tolerance=1e-6, maxIterations=500, asynchronous=false, skipCheck=0}
+// @returns {ranks, iterations, time}
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpFused(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
+  auto ks = pagerankVertices(x, xt, o, D);
+  return pagerankFusedOmp(xt, ks, N, q, o);
+}
+
+template <class G, class T=float>
+PagerankResult<T> pagerankMonolithicOmpFused(const G& x, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  auto xt = transposeWithDegree(x);
+  return pagerankMonolithicOmpFused(x, xt, q, o, D);
+}
+
+
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpDynamicFused(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N = yt.order();                                         if (N==0) return PagerankResult<T>::initial(yt, q);
+  auto [ks, n] = pagerankDynamicVertices(x, xt, y, yt, o, D);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  return pagerankFusedOmp(yt, ks, n, q, o);
+}
+
+template <class G, class T=float>
+PagerankResult<T> pagerankMonolithicOmpDynamicFused(const G& x, const G& y, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  auto xt = transposeWithDegree(x);
+  auto yt = transposeWithDegree(y);
+  return pagerankMonolithicOmpDynamicFused(x, xt, y, yt, q, o, D);
+}
+
+
+
+
+// PAGERANK-FRONTIER
+// -----------------
+// Add vertices (us), if keep, and their out-neighbours to frontier (a),
+// through per-thread queues. Marks (vis) are cleared once done.
+// Large frontiers are marked with atomic writes (no capture), and collected
+// by a scan; nearly full ones just take all vertices.
+
+template <class J>
+void pagerankFrontierAddOmp(vector<int>& a, vector<char>& vis, vector2d<int>& qs, const vector<size_t>& vfrom, const vector<int>& efrom, const J& us, bool keep) {
+  auto fp = [&](vector<int>& q, int v) {
+    char w;
+    #pragma omp atomic capture
+    { w = vis[v]; vis[v] = 1; }
+    if (!w) q.push_back(v);
+  };
+  int U = us.size(), N = vis.size();
+  bool dense = U > N/64;
+  if (U > N/4) { a.resize(N); iota(a.begin(), a.end(), 0); return; }
+  #pragma omp parallel
+  {
+    auto& q = qs[omp_get_thread_num()]; q.clear();
+    #pragma omp for schedule(dynamic, CHUNK_SIZE_FRONTIER)
+    for (int i=0; i<U; i++) {
+      int u = us[i];
+      if (dense) {
+        if (keep) {
+          #pragma omp atomic write
+          vis[u] = 1;
+        }
+        for (size_t j=vfrom[u]; j<vfrom[u+1]; j++) {
+          #pragma omp atomic write
+          vis[efrom[j]] = 1;
+        }
+        continue;
+      }
+      if (keep) fp(q, u);
+      for (size_t j=vfrom[u]; j<vfrom[u+1]; j++)
+        fp(q, efrom[j]);
+    }
+    if (dense) {
+      #pragma omp for schedule(static)
+      for (int v=0; v<N; v++)
+        if (vis[v]) q.push_back(v);
+    }
+  }
+  a.clear();
+  for (const auto& q : qs)
+    append(a, q);
+  #pragma omp parallel for schedule(runtime)
+  for (size_t i=0; i<a.size(); i++)
+    vis[a[i]] = 0;
+}
+
+
+// Recompute ranks of frontier vertices (ks) only, until tolerance is met,
+// or no vertex changes by more than frontier tolerance (F).
+template <class T>
+int pagerankFrontierOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const vector<size_t>& vfrom, const vector<int>& efrom, const vector<size_t>& ofrom, const vector<int>& oto, const vector<int>& ks, int N, T p, T E, T F, int L, int EF) {
+  T  c0 = (1-p)/N;
+  int l = 0;
+  vector<int> frnt, frnu;
+  vector<char> vis(N);
+  vector<T> es(N);
+  vector2d<int> qs(omp_get_max_threads());
+  pagerankFrontierAddOmp(frnt, vis, qs, ofrom, oto, ks, true);
+  while (l<L && !frnt.empty()) {
+    int n = frnt.size();
+    #pragma omp parallel for schedule(runtime)
+    for (int i=0; i<n; i++) {
+      int v = frnt[i];
+      a[v]  = c0 + sumAtSimd(c.data(), efrom.data()+vfrom[v], efrom.data()+vfrom[v+1]);
+      es[i] = abs(a[v] - r[v]);
+    }
+    T el = EF==1? sumOmp(es, 0, n) : EF==2? sqrt(sumSqrOmp(es, 0, n)) : maxOmp(es, 0, n); ++l;
+    // Commit ranks, and expand along significant changes only. Changed
+    // vertices are collected in per-thread queues, while committing.
+    #pragma omp parallel
+    {
+      auto& q = qs[omp_get_thread_num()]; q.clear();
+      #pragma omp for schedule(runtime)
+      for (int i=0; i<n; i++) {
+        int v = frnt[i];
+        r[v] = a[v];
+        c[v] = a[v] * f[v];
+        if (es[i] > F) q.push_back(v);
+      }
+    }
+    if (el<E) break;
+    frnu.clear();
+    for (const auto& q : qs)
+      append(frnu, q);
+    pagerankFrontierAddOmp(frnt, vis, qs, ofrom, oto, frnu, true);
+  }
+  return l;
+}
+
+
+
+
+// PAGERANK (DYNAMIC FRONTIER)
+// ---------------------------
+// Only vertices near changed ones are recomputed, and a vertex's
+// out-neighbours join the frontier only if its rank changed significantly.
+
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpDynamicFrontier(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  auto vs = D && !D->changedVertices.empty()? D->changedVertices : changedVertices(x, xt, y, yt);
+  if (vs.empty()) return PagerankResult<T>::initial(yt, q);
+  T    p  = o.damping;
+  T    E  = o.tolerance;
+  T    F  = o.frontierTolerance>0? o.frontierTolerance : E/N;
+  int  L  = o.maxIterations, l = 0;
+  int  EF = o.toleranceNorm;
+  auto ks = vertices(yt);
+  vector<size_t> vfrom0, ofrom0; vector<int> efrom0, oto0, vdata0;
+  const auto& vfrom = sourceOffsetsTo(vfrom0, yt, ks);
+  const auto& efrom = destinationIndicesTo(efrom0, yt, ks);
+  const auto& vdata = vertexDataTo(vdata0, yt, ks);
+  const auto& ofrom = sourceOffsetsTo(ofrom0, y, ks);  // out-edges, to expand frontier
+  const auto& oto   = destinationIndicesTo(oto0, y, ks);
+  auto is = createContainer(yt, int());
+  for (int i=0; i<N; i++)
+    is[ks[i]] = i;
+  vector<int> us;
+  for (int u : vs)
+    if (yt.hasVertex(u)) us.push_back(is[u]);
+  vector<T> a(N), r(N), c(N), f(N), qc;
+  if (q) qc = compressContainer(yt, *q, ks);
+  float t = 0;
+  withOptionsOmp(o, [&] {
+    t = measureDurationMarked([&](auto mark) {
+      if (q) copyOmp(r, qc);    // copy old ranks (qc), if given
+      else fillOmp(r, T(1)/N);
+      copyOmp(a, r);
+      mark([&] { pagerankFactorOmp(f, vdata, 0, N, p); multiplyOmp(c, a, f, 0, N); });
+      mark([&] { l = pagerankFrontierOmpLoop(a, r, c, f, vfrom, efrom, ofrom, oto, us, N, p, E, F, L, EF); });
+    }, o.repeat);
+  });
+  return {decompressContainer(yt, a, ks), l, t};
+}
+
+template <class G, class T=float>
+PagerankResult<T> pagerankMonolithicOmpDynamicFrontier(const G& x, const G& y, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  auto xt = transposeWithDegree(x);
+  auto yt = transposeWithDegree(y);
+  return pagerankMonolithicOmpDynamicFrontier(x, xt, y, yt, q, o, D);
+}
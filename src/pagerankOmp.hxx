@@ -10,6 +10,8 @@
 
 using std::vector;
 using std::swap;
+using std::min;
+using std::lower_bound;
 
 
 
@@ -20,7 +22,7 @@ using std::swap;
 
 template <class T>
 void pagerankFactorOmp(vector<T>& a, const vector<int>& vdata, int i, int n, T p) {
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(runtime)
   for (int u=i; u<i+n; u++) {
     int d = vdata[u];
     a[u] = d>0? p/d : 0;
@@ -33,12 +35,30 @@ void pagerankFactorOmp(vector<T>& a, const vector<int>& vdata, int i, int n, T p
 // PAGERANK-CALCULATE
 // ------------------
 // For rank calculation from in-edges.
+// Each thread takes an equal share of edges, so that hubs do not hold up the
+// rest. In-edges of a vertex crossing into the next share(s) are summed there,
+// and these partial sums are added at the end.
 
 template <class T>
 void pagerankCalculateOmp(vector<T>& a, const vector<T>& c, const vector<size_t>& vfrom, const vector<int>& efrom, int i, int n, T c0) {
-  #pragma omp parallel for num_threads(32) schedule(auto)
-  for (int v=i; v<i+n; v++)
-    a[v] = c0 + sumAt(c, sliceIter(efrom, vfrom[v], vfrom[v+1]));
+  size_t E0 = vfrom[i], E1 = vfrom[i+n];
+  int P = omp_get_max_threads();
+  vector<int> ws(P, -1);
+  vector<T>   ss(P);
+  #pragma omp parallel
+  {
+    int t = omp_get_thread_num(), P = omp_get_num_threads();
+    size_t eb = E0 + (E1-E0)*t/P, ee = E0 + (E1-E0)*(t+1)/P;
+    auto fb = vfrom.begin()+i, fe = vfrom.begin()+i+n;
+    int vb = lower_bound(fb, fe, eb) - vfrom.begin();
+    int ve = t==P-1? i+n : int(lower_bound(fb, fe, ee) - vfrom.begin());
+    const int *e = efrom.data();
+    if (vb>i && vfrom[vb]>eb) { ws[t] = vb-1; ss[t] = sumAtSimd(c.data(), e+eb, e+min(vfrom[vb], ee)); }
+    for (int v=vb; v<ve; v++)
+      a[v] = c0 + sumAtSimd(c.data(), e+vfrom[v], e+min(vfrom[v+1], ee));
+  }
+  for (int t=0; t<P; t++)
+    if (ws[t]>=0) a[ws[t]] += ss[t];
 }
 
 
@@ -64,24 +84,29 @@ T pagerankErrorOmp(const vector<T>& x, const vector<T>& y, int i, int N, int EF)
 // --------
 // For Monolithic / Componentwise PageRank.
 
+// Loops that do not read previous ranks (r), e.g. asynchronous, can skip it.
 template <class H, class J, class M, class FL, class T=float>
-PagerankResult<T> pagerankOmp(const H& xt, const J& ks, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o) {
+PagerankResult<T> pagerankOmp(const H& xt, const J& ks, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o, bool prev=true) {
   int  N  = xt.order();
   T    p  = o.damping;
   T    E  = o.tolerance;
   int  L  = o.maxIterations, l = 0;
   int  EF = o.toleranceNorm;
-  auto vfrom = sourceOffsets(xt, ks);
-  auto efrom = destinationIndices(xt, ks);
-  auto vdata = vertexData(xt, ks);
-  vector<T> a(N), r(N), c(N), f(N), qc;
+  vector<size_t> vfrom0; vector<int> efrom0, vdata0;
+  const auto& vfrom = sourceOffsetsTo(vfrom0, xt, ks);     // reuse CSR of flat graph,
+  const auto& efrom = destinationIndicesTo(efrom0, xt, ks);  // if vertex order matches
+  const auto& vdata = vertexDataTo(vdata0, xt, ks);
+  vector<T> a(N), r(prev? N : 0), c(N), f(N), qc;
   if (q) qc = compressContainer(xt, *q, ks);
-  float t = measureDurationMarked([&](auto mark) {
-    if (q) copyOmp(r, qc);    // copy old ranks (qc), if given
-    else fillOmp(r, T(1)/N);
-    copyOmp(a, r);
-    mark([&] { pagerankFactorOmp(f, vdata, 0, N, p); multiplyOmp(c, a, f, 0, N); });  // calculate factors (f) and contributions (c)
-    mark([&] { l = fl(a, r, c, f, vfrom, efrom, i, ns, N, p, E, L, EF); });           // calculate ranks of vertices
-  }, o.repeat);
+  float t = 0;
+  withOptionsOmp(o, [&] {
+    t = measureDurationMarked([&](auto mark) {
+      if (q) copyOmp(a, qc);    // copy old ranks (qc), if given
+      else fillOmp(a, T(1)/N);
+      if (prev) copyOmp(r, a);
+      mark([&] { pagerankFactorOmp(f, vdata, 0, N, p); multiplyOmp(c, a, f, 0, N); });  // calculate factors (f) and contributions (c)
+      mark([&] { l = fl(a, r, c, f, vfrom, efrom, i, ns, N, p, E, L, EF); });           // calculate ranks of vertices
+    }, o.repeat);
+  });
   return {decompressContainer(xt, a, ks), l, t};
 }
@@ -0,0 +1,252 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "_main.hxx"
+#include "DiGraph.hxx"
+#include "DiGraphCsr.hxx"
+#include "vertices.hxx"
+#include "identicals.hxx"
+#include "pagerank.hxx"
+
+using std::vector;
+using std::pair;
+using std::make_pair;
+using std::move;
+using std::sort;
+
+
+
+
+// PAGERANK-REDUCTION
+// ------------------
+// Vertices whose ranks follow from others, and need not be solved for.
+// Identicals have the same in-edges and out-degree, and so the same rank as
+// their representative, which takes their place as source of their edges.
+// Chains hang off the graph: each vertex has a single in-edge (apart from a
+// self-loop), and out-edges only to later chain vertices (or itself), so that
+// the rest of the graph is unaffected by them. Ranks of both are found once
+// the reduced graph is solved. Vertices keep their ids in the reduced graph.
+
+struct PagerankReduction {
+  vector<int>   representative;  // of each vertex: itself if kept, -1 if on a chain
+  vector<char>  reduced;         // is vertex in a group of identicals, or a chain
+  vector<int>   chains;          // chain vertices, each after its predecessor
+  vector2d<int> identicals;      // groups of identicals, representative first
+};
+
+
+inline int reductionRepresentative(const PagerankReduction& R, int u) {
+  return u < int(R.representative.size())? R.representative[u] : u;
+}
+
+inline bool reductionReduced(const PagerankReduction& R, int u) {
+  return u < int(R.reduced.size()) && R.reduced[u];
+}
+
+
+// Single in-edge of a vertex, apart from a self-loop (-1 if none, or many).
+template <class H>
+int chainPredecessor(const H& xt, int v) {
+  int a = -1, n = 0;
+  for (int u : xt.edges(v)) {
+    if (u==v) continue;
+    a = u; n++;
+  }
+  return n==1? a : -1;
+}
+
+
+template <class G, class H>
+auto reductionChains(const G& x, const H& xt, const vector<char>& fixed) {
+  int S = x.span();
+  vector<char> on(S);
+  vector<int>  us, a;
+  auto fp = [&](int v) { return v < int(fixed.size()) && fixed[v]; };
+  for (int v : x.vertices())
+    if (!fp(v) && chainPredecessor(xt, v)>=0) { on[v] = 1; us.push_back(v); }
+  // Drop vertices leading out of chains, and recheck their predecessors.
+  while (!us.empty()) {
+    int v = us.back(); us.pop_back();
+    if (!on[v]) continue;
+    bool out = false;
+    for (int w : x.edges(v))
+      out |= w!=v && !on[w];
+    if (!out) continue;
+    on[v] = 0;
+    int u = chainPredecessor(xt, v);
+    if (on[u]) us.push_back(u);
+  }
+  // Order from heads, vertices on cycles of their own are not reached.
+  for (int v : x.vertices())
+    if (on[v] && !on[chainPredecessor(xt, v)]) a.push_back(v);
+  for (size_t i=0; i<a.size(); i++) {
+    for (int w : x.edges(a[i]))
+      if (w!=a[i] && on[w]) a.push_back(w);
+  }
+  return a;
+}
+
+
+// Find reduction of a graph, leaving fixed vertices (ex) as they are.
+// @param x  original graph
+// @param xt transpose graph (with vertex-data=out-degree)
+// @param ex vertices to keep, unreduced (optional)
+// @returns reduction
+template <class G, class H>
+auto pagerankReduction(const G& x, const H& xt, const vector<int>& ex={}) {
+  int S = x.span();
+  PagerankReduction a;
+  a.representative.resize(S);
+  a.reduced.resize(S);
+  vector<char> fixed(S);
+  for (int u : ex)
+    if (u<S) fixed[u] = 1;
+  for (int u=0; u<S; u++)
+    a.representative[u] = u;
+  // Chains first, as in-edges of others never come from them.
+  a.chains = reductionChains(x, xt, fixed);
+  for (int v : a.chains) {
+    a.representative[v] = -1;
+    a.reduced[v] = fixed[v] = 1;
+  }
+  // Identicals, split by out-degree.
+  vector<int> ks;
+  for (int u : x.vertices())
+    if (!fixed[u]) ks.push_back(u);
+  for (auto& g : edgeIdenticalsFromSize(xt, ks, 2)) {
+    sort(g.begin(), g.end(), [&](int u, int v) { return make_pair(x.degree(u), u) < make_pair(x.degree(v), v); });
+    for (size_t i=0, j=0; i<g.size(); i=j) {
+      for (j=i+1; j<g.size() && x.degree(g[j])==x.degree(g[i]); j++);
+      if (j-i<2) continue;
+      vector<int> b(g.begin()+i, g.begin()+j);
+      for (int u : b) {
+        a.representative[u] = b[0];
+        a.reduced[u] = 1;
+      }
+      a.identicals.push_back(move(b));
+    }
+  }
+  return a;
+}
+
+
+// Is reduction affected by changes to vertices (vs)?
+// If not, it can be reused for the updated graph, which differs only there.
+template <class J>
+bool pagerankReductionAffected(const PagerankReduction& R, const J& vs) {
+  for (int u : vs)
+    if (reductionReduced(R, u)) return true;
+  return false;
+}
+
+
+
+
+// PAGERANK-REDUCE-GRAPH
+// ---------------------
+// Reduced graph, and its transpose (with vertex-data=out-degree in original).
+// Edges from identicals go from their representative, and may be repeated
+// in transpose, so that each still adds its contribution.
+
+template <class G, class H>
+auto pagerankReduceGraph(const PagerankReduction& R, const G& x, const H& xt) {
+  using V = typename H::TVertex;
+  int  S = x.span(), B = 0;
+  auto fr = [&](int u) { return reductionRepresentative(R, u); };
+  auto fk = [&](int u) { return x.hasVertex(u) && fr(u)==u; };
+  G a;
+  for (int u : x.vertices())
+    if (fk(u)) a.addVertex(u, x.vertexData(u));
+  for (int u : x.vertices()) {
+    if (fr(u)<0) continue;
+    for (int v : x.edges(u))
+      if (fr(v)>=0) a.addEdge(fr(u), fr(v));
+  }
+  a.correct();
+  while (B<S && !fk(B)) B++;
+  vector<size_t> vfrom(S-B+1);
+  vector<char>   ex(S-B);
+  vector<V>      vdata(S-B);
+  size_t i = 0;
+  for (int v=B; v<S; v++) {
+    vfrom[v-B] = i;
+    ex[v-B]    = fk(v);
+    vdata[v-B] = fk(v)? xt.vertexData(v) : V();
+    if (fk(v)) i += xt.degree(v);
+  }
+  vfrom[S-B] = i;
+  vector<int> efrom(i);
+  #pragma omp parallel for schedule(runtime)
+  for (int v=B; v<S; v++) {
+    if (!fk(v)) continue;
+    size_t j = vfrom[v-B];
+    for (int u : xt.edges(v))
+      efrom[j++] = fr(u)-B;
+    sort(efrom.begin()+vfrom[v-B], efrom.begin()+j);
+  }
+  auto at = DiGraphCsr<V>(B, move(vfrom), move(efrom), move(ex), move(vdata));
+  return make_pair(move(a), move(at));
+}
+
+
+
+
+// PAGERANK-EXPAND-RANKS
+// ---------------------
+// Ranks of reduced graph (a) are scaled down to the full graph, as teleport
+// is shared by more vertices, then identicals copy their representative, and
+// chains are found from their head in closed form (with self-loop, if any).
+
+template <class H, class T>
+void pagerankExpandRanks(vector<T>& a, const PagerankReduction& R, const H& xt, int n, T p) {
+  int N = xt.order();
+  T  c0 = (1-p)/N, s = T(n)/N;
+  a.resize(xt.span());
+  for (int u : xt.vertices())
+    a[u] *= s;
+  for (const auto& g : R.identicals) {
+    for (size_t i=1; i<g.size(); i++)
+      if (xt.hasVertex(g[i])) a[g[i]] = a[g[0]];
+  }
+  for (int v : R.chains) {
+    if (!xt.hasVertex(v)) continue;
+    T c = c0, l = 0;
+    for (int u : xt.edges(v)) {
+      T f = p/coalesce(int(xt.vertexData(u)), 1);
+      if (u==v) l += f;
+      else c += f * a[u];
+    }
+    a[v] = c / (1-l);
+  }
+}
+
+
+
+
+// PAGERANK (REDUCED)
+// ------------------
+
+// Find pagerank by solving a reduced graph, and expanding its ranks.
+// @param xt  transpose graph (with vertex-data=out-degree)
+// @param R   reduction of graph
+// @param xrt reduced transpose graph
+// @param fe  solver, given initial ranks of reduced graph (qr) and options
+// @param q   initial ranks (optional)
+// @param o   options {damping=0.85, tolerance=1e-6, maxIterations=500}
+// @returns {ranks, iterations, time}
+template <class H, class HR, class FE, class T=float>
+PagerankResult<T> pagerankReduced(const H& xt, const PagerankReduction& R, const HR& xrt, FE fe, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}) {
+  int N = xt.order(), n = xrt.order();
+  T   p = o.damping, s = T(N)/coalesce(n, 1);
+  // Ranks of reduced graph are larger, so are its tolerances.
+  auto oq = o;
+  oq.tolerance *= s;
+  oq.frontierTolerance = (o.frontierTolerance>0? o.frontierTolerance : o.tolerance/N) * s;
+  vector<T> qr;
+  if (q) qr = *q;
+  if (q) multiplyValue(qr, qr, s);
+  PagerankResult<T> a = fe(q? &qr : nullptr, oq);
+  a.time += measureDuration([&] { pagerankExpandRanks(a.ranks, R, xt, n, p); });  // once, in place
+  return a;
+}
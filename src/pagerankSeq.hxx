@@ -25,10 +25,10 @@ auto pagerankVertices(const G& x, const H& xt, const PagerankOptions<T>& o, cons
 
 template <class G, class H, class T>
 auto pagerankDynamicVertices(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
-  if (!o.splitComponents) return dynamicVertices(x, xt, y, yt);
+  if (!o.splitComponents) return dynamicVerticesD(x, xt, y, yt, D);
   const auto& cs = componentsD(y, yt, D);
   const auto& b  = blockgraphD(y, cs, D);
-  auto [is, n] = dynamicComponentIndices(x, xt, y, yt, cs, b);
+  auto [is, n] = dynamicComponentIndicesD(x, xt, y, yt, cs, b, D);
   auto ks = joinAt<int>(cs, sliceIter(is, 0, n)); size_t nv = ks.size();
   joinAt(ks, cs, sliceIter(is, n));
   return make_pair(ks, nv);
@@ -48,9 +48,9 @@ auto pagerankComponents(const G& x, const H& xt, const PagerankOptions<T>& o, co
 
 
 template <class G, class H>
-auto pagerankDynamicComponentsDefault(const G& x, const H& xt, const G& y, const H& yt) {
+auto pagerankDynamicComponentsDefault(const G& x, const H& xt, const G& y, const H& yt, const PagerankData<G> *D=nullptr) {
   vector2d<int> a;
-  auto [ks, n] = dynamicVertices(x, xt, y, yt);
+  auto [ks, n] = dynamicVerticesD(x, xt, y, yt, D);
   a.push_back(vector<int>(ks.begin(), ks.begin()+n));
   a.push_back(vector<int>(ks.begin()+n, ks.end()));
   return make_pair(a, size_t(1));
@@ -60,7 +60,7 @@ template <class G, class H, class T>
 auto pagerankDynamicComponentsSplit(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
   const auto& cs = componentsD(y, yt, D);
   const auto& b  = blockgraphD(y, cs, D);
-  auto [is, n] = dynamicComponentIndices(x, xt, y, yt, cs, b);
+  auto [is, n] = dynamicComponentIndicesD(x, xt, y, yt, cs, b, D);
   vector2d<int> a;
   for (int i : is)
     a.push_back(cs[i]);
@@ -70,7 +70,7 @@ auto pagerankDynamicComponentsSplit(const G& x, const H& xt, const G& y, const H
 template <class G, class H, class T>
 auto pagerankDynamicComponents(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
   if (o.splitComponents) return pagerankDynamicComponentsSplit(x, xt, y, yt, o, D);
-  return pagerankDynamicComponentsDefault(x, xt, y, yt);
+  return pagerankDynamicComponentsDefault(x, xt, y, yt, D);
 }
 
 
@@ -131,9 +131,10 @@ PagerankResult<T> pagerankSeq(const H& xt, const J& ks, int i, const M& ns, FL f
   T    E  = o.tolerance;
   int  L  = o.maxIterations, l = 0;
   int  EF = o.toleranceNorm;
-  auto vfrom = sourceOffsets(xt, ks);
-  auto efrom = destinationIndices(xt, ks);
-  auto vdata = vertexData(xt, ks);
+  vector<size_t> vfrom0; vector<int> efrom0, vdata0;
+  const auto& vfrom = sourceOffsetsTo(vfrom0, xt, ks);     // reuse CSR of flat graph,
+  const auto& efrom = destinationIndicesTo(efrom0, xt, ks);  // if vertex order matches
+  const auto& vdata = vertexDataTo(vdata0, xt, ks);
   vector<T> a(N), r(N), c(N), f(N), qc;
   if (q) qc = compressContainer(xt, *q, ks);
   float t = measureDurationMarked([&](auto mark) {
@@ -1,13 +1,14 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <utility>
 #include <istream>
-#include <sstream>
+#include "_main.hxx"
 
 using std::string;
 using std::vector;
+using std::pair;
 using std::istream;
-using std::stringstream;
 using std::getline;
 
 
@@ -16,11 +17,20 @@ using std::getline;
 // READ-SNAP-TEMPORAL
 // ------------------
 
+// Parse edge (u, v) at time (t) from a line, without a stream per line.
+bool readSnapTemporalEdge(int& u, int& v, int& t, const string& ln) {
+  const char *ib = ln.data(), *ie = ib + ln.size();
+  const char *iu = readInteger(u, ib, ie);
+  const char *iv = readInteger(v, iu, ie);
+  const char *it = readInteger(t, iv, ie);
+  return iu!=ib && iv!=iu && it!=iv;
+}
+
+
 template <class G>
 bool readSnapTemporalLine(G& a, const string& ln, bool sym=false) {
   int u, v, t;
-  stringstream ls(ln);
-  if (!(ls >> u >> v >> t)) return false;
+  if (!readSnapTemporalEdge(u, v, t, ln)) return false;
   a.addEdge(u, v);
   if (sym) a.addEdge(v, u);
   return true;
@@ -36,3 +46,31 @@ bool readSnapTemporal(G& a, istream& s, size_t N, bool sym=false) {
   }
   return i>0;
 }
+
+
+
+
+// READ-SNAP-TEMPORAL-BATCH
+// ------------------------
+// Read next edges of a stream (file or pipe) into a sorted batch, so that
+// it can be applied with updateBatchOmp(). Buffer (a) is reused.
+
+// @param a   batch of edges (output)
+// @param s   input stream
+// @param N   number of edges to read
+// @param sym add reverse edges too?
+// @returns number of edges read (0 => end of stream)
+size_t readSnapTemporalBatch(vector<pair<int, int>>& a, istream& s, size_t N, bool sym=false) {
+  string ln; size_t n = 0;
+  a.clear();
+  while (n<N && getline(s, ln)) {
+    int u, v, t;
+    if (!readSnapTemporalEdge(u, v, t, ln)) continue;  // skip comments, bad lines
+    if (u<0 || v<0) continue;
+    a.push_back({u, v});
+    if (sym) a.push_back({v, u});
+    n++;
+  }
+  sortUnique(a);
+  return n;
+}
@@ -1,5 +1,15 @@
 #pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "_main.hxx"
 #include "DiGraph.hxx"
+#include "DiGraphCsr.hxx"
+#include "copy.hxx"
+
+using std::vector;
+using std::move;
+using std::sort;
 
 
 
@@ -47,3 +57,82 @@ auto transposeWithDegree(const G& x) {
   DiGraph<int, E> a; transposeWithDegree(a, x);
   return a;
 }
+
+
+
+
+// TRANSPOSE (CSR)
+// ---------------
+// Counting sort of edges by destination, in parallel.
+// Vertex data of transpose is given by (fv).
+
+template <class V, class E, class FV>
+auto transposeOmp(const DiGraphCsr<V, E>& x, FV fv) {
+  using W = decltype(fv(0));
+  int B = x.base(), n = x.span()-B;
+  const auto& vfrom = x.sourceOffsets();
+  const auto& efrom = x.destinationIndices();
+  vector<int>    degs(n);
+  vector<size_t> afrom, cur;
+  vector<char>   ex(n);
+  vector<W>      vdata(n);
+  // Count in-degree of each vertex.
+  #pragma omp parallel for schedule(runtime)
+  for (size_t i=0; i<efrom.size(); i++) {
+    #pragma omp atomic
+    degs[efrom[i]]++;
+  }
+  csrOffsets(afrom, degs); cur = afrom;
+  // Place each edge at its destination (order fixed below).
+  vector<int> aedge(efrom.size());
+  #pragma omp parallel for schedule(runtime)
+  for (int u=0; u<n; u++) {
+    for (size_t i=vfrom[u]; i<vfrom[u+1]; i++) {
+      size_t k;
+      #pragma omp atomic capture
+      k = cur[efrom[i]]++;
+      aedge[k] = u;
+    }
+  }
+  #pragma omp parallel for schedule(runtime)
+  for (int v=0; v<n; v++) {
+    sort(aedge.begin()+afrom[v], aedge.begin()+afrom[v+1]);
+    ex[v]    = x.hasVertex(v+B);
+    vdata[v] = fv(v+B);
+  }
+  return DiGraphCsr<W, E>(B, move(afrom), move(aedge), move(ex), move(vdata));
+}
+
+template <class V, class E>
+auto transposeOmp(const DiGraphCsr<V, E>& x) {
+  return transposeOmp(x, [&](int u) { return x.vertexData(u); });
+}
+
+template <class V, class E>
+auto transpose(const DiGraphCsr<V, E>& x) {
+  return transposeOmp(x);
+}
+
+
+template <class V, class E>
+auto transposeWithDegreeOmp(const DiGraphCsr<V, E>& x) {
+  return transposeOmp(x, [&](int u) { return x.degree(u); });
+}
+
+template <class V, class E>
+auto transposeWithDegree(const DiGraphCsr<V, E>& x) {
+  return transposeWithDegreeOmp(x);
+}
+
+
+// Transpose (CSR) of a graph, through its CSR, in parallel.
+template <class G>
+auto transposeWithDegreeOmp(const G& x) {
+  return transposeWithDegreeOmp(digraphCsrOmp(x));
+}
+
+// Transpose into a DiGraph, that batch updates can keep up to date.
+template <class H, class G>
+void transposeWithDegreeOmp(H& a, const G& x) {
+  copyToOmp(a, transposeWithDegreeOmp(x));
+}